@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "alloc_stats.hpp"
+
+namespace alg::bench {
+
+// 被测容器的分配都记入 "bench" 标签
+struct BenchAllocTag {
+    static constexpr const char *name = "bench";
+};
+template <typename T>
+using BenchAllocator = StatsAllocator<T, BenchAllocTag>;
+
+inline AllocStats &bench_alloc_stats() { return BenchAllocator<char>::stats(); }
+
+class Stopwatch {
+public:
+    Stopwatch() : _start(std::chrono::steady_clock::now()) {}
+
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point _start;
+};
+
+// 防止编译器把被测代码当作无用代码删除
+inline volatile size_t __keep_sink;
+inline void keep(size_t value) { __keep_sink = value; }
+
+// 一条测量结果, 按 JSON 对象输出
+struct Result {
+    std::string suite;
+    std::string name;
+    std::string container;
+    std::string element;
+    size_t n = 0;
+    double seconds = 0;
+    size_t allocations = 0;
+    size_t bytes = 0;
+    size_t peak_bytes = 0;
+    std::vector<std::pair<std::string, double>> extra;  // 各个测试自己的指标
+};
+
+// 只统计 f 执行期间的时间和分配
+template <typename F>
+Result measure(const char *suite, const char *name, const char *container, const char *element,
+               size_t n, F f) {
+    Result r;
+    r.suite = suite;
+    r.name = name;
+    r.container = container;
+    r.element = element;
+    r.n = n;
+    AllocStats &stats = bench_alloc_stats();
+    stats.reset();
+    size_t live = stats.snapshot().live_bytes;
+    Stopwatch watch;
+    f();
+    r.seconds = watch.seconds();
+    AllocStats::Snapshot s = stats.snapshot();
+    r.allocations = s.allocations;
+    r.bytes = s.bytes_allocated;
+    r.peak_bytes = s.peak_live_bytes - live;
+    return r;
+}
+
+inline std::string json_escape(const std::string &str) {
+    std::string result;
+    for (char c : str) {
+        if (c == '"' || c == '\\') result += '\\';
+        result += c;
+    }
+    return result;
+}
+
+inline void print_json(std::FILE *out, const std::vector<Result> &results) {
+    std::fprintf(out, "{\n  \"benchmarks\": [");
+    for (size_t i = 0; i != results.size(); ++i) {
+        const Result &r = results[i];
+        std::fprintf(out,
+                     "%s\n    {\"suite\": \"%s\", \"name\": \"%s\", \"container\": \"%s\", "
+                     "\"element\": \"%s\", \"n\": %zu, \"seconds\": %.9f, "
+                     "\"ops_per_second\": %.1f, \"allocations\": %zu, \"bytes_allocated\": %zu, "
+                     "\"peak_bytes\": %zu",
+                     i == 0 ? "" : ",", json_escape(r.suite).c_str(), json_escape(r.name).c_str(),
+                     json_escape(r.container).c_str(), json_escape(r.element).c_str(), r.n,
+                     r.seconds, r.seconds > 0 ? r.n / r.seconds : 0.0, r.allocations, r.bytes,
+                     r.peak_bytes);
+        for (auto &kv : r.extra) {
+            std::fprintf(out, ", \"%s\": %.9g", json_escape(kv.first).c_str(), kv.second);
+        }
+        std::fprintf(out, "}");
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+}  // namespace alg::bench
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <stack>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "bench_utility.hpp"
+#include "resizing_array.hpp"
+#include "stack.hpp"
+#include "vector.hpp"
+
+namespace alg::bench {
+
+namespace {
+
+// 三类元素: 平凡可复制, 只能移动, 持有堆内存 (长度超过常见的短字符串优化)
+template <typename T>
+T make(size_t i);
+template <>
+int make<int>(size_t i) {
+    return static_cast<int>(i);
+}
+template <>
+std::unique_ptr<int> make<std::unique_ptr<int>>(size_t i) {
+    return std::make_unique<int>(static_cast<int>(i));
+}
+template <>
+std::string make<std::string>(size_t i) {
+    return "container-benchmark-" + std::to_string(i);
+}
+
+template <typename T>
+const char *element_name();
+template <>
+const char *element_name<int>() {
+    return "int";
+}
+template <>
+const char *element_name<std::unique_ptr<int>>() {
+    return "unique_ptr<int>";
+}
+template <>
+const char *element_name<std::string>() {
+    return "string";
+}
+
+template <typename T>
+using AlgVector = Vector<T, BenchAllocator<T>>;
+template <typename T>
+using AlgResizingArray = ResizingArray<T, BenchAllocator<T>>;
+template <typename T>
+using StdVector = std::vector<T, BenchAllocator<T>>;
+template <typename T>
+using AlgStack = Stack<T, ResizingArray<T, BenchAllocator<T>>>;
+template <typename T>
+using StdStack = std::stack<T, std::deque<T, BenchAllocator<T>>>;
+
+template <typename C>
+C filled(size_t n) {
+    C c;
+    for (size_t i = 0; i != n; ++i) c.push_back(make<typename C::value_type>(i));
+    return c;
+}
+
+template <typename C>
+void bench_sequence(std::vector<Result> &results, const char *container, size_t n) {
+    using T = typename C::value_type;
+    const char *element = element_name<T>();
+    // 中间插入和删除是 O(n^2) 的, 规模单独限制
+    size_t quadratic_n = std::min<size_t>(n, 20000);
+
+    results.push_back(measure("containers", "append", container, element, n, [n] {
+        C c;
+        for (size_t i = 0; i != n; ++i) c.push_back(make<T>(i));
+        keep(c.size());
+    }));
+    if constexpr (std::is_copy_constructible_v<T>) {
+        C src = filled<C>(n);
+        results.push_back(measure("containers", "copy", container, element, n, [&src] {
+            C c(src);
+            keep(c.size());
+        }));
+    }
+    {
+        // 每轮先收缩到恰好装满, 再追加一个元素, 迫使全部元素搬迁一次
+        const size_t rounds = 16;
+        C c = filled<C>(n);
+        results.push_back(measure("containers", "regrow", container, element, n * rounds, [&c] {
+            for (size_t r = 0; r != rounds; ++r) {
+                c.shrink_to_fit();
+                c.push_back(make<T>(r));
+            }
+            keep(c.size());
+        }));
+    }
+    if constexpr (!std::is_same_v<C, AlgResizingArray<T>>) {
+        results.push_back(measure("containers", "middle_insert", container, element, quadratic_n,
+                                  [quadratic_n] {
+                                      C c;
+                                      for (size_t i = 0; i != quadratic_n; ++i) {
+                                          c.insert(c.begin() + c.size() / 2, make<T>(i));
+                                      }
+                                      keep(c.size());
+                                  }));
+        C c = filled<C>(quadratic_n);
+        results.push_back(
+            measure("containers", "middle_erase", container, element, quadratic_n, [&c] {
+                while (!c.empty()) c.erase(c.begin() + c.size() / 2);
+                keep(c.size());
+            }));
+    }
+}
+
+template <typename S>
+void bench_stack(std::vector<Result> &results, const char *container, size_t n) {
+    using T = typename S::value_type;
+    results.push_back(measure("containers", "push_pop", container, element_name<T>(), n, [n] {
+        S s;
+        for (size_t i = 0; i != n; ++i) s.push(make<T>(i));
+        size_t sum = 0;
+        while (!s.empty()) {
+            if constexpr (std::is_same_v<S, StdStack<T>>) {
+                s.pop();
+            } else {
+                T v = s.pop();
+                (void)v;
+            }
+            ++sum;
+        }
+        keep(sum);
+    }));
+}
+
+template <typename T>
+void bench_element(std::vector<Result> &results, size_t n) {
+    bench_sequence<AlgResizingArray<T>>(results, "alg::ResizingArray", n);
+    bench_sequence<AlgVector<T>>(results, "alg::Vector", n);
+    bench_sequence<StdVector<T>>(results, "std::vector", n);
+    bench_stack<AlgStack<T>>(results, "alg::Stack", n);
+    bench_stack<StdStack<T>>(results, "std::stack", n);
+}
+
+}  // namespace
+
+void run_container_benchmarks(std::vector<Result> &results, size_t n) {
+    bench_element<int>(results, n);
+    bench_element<std::unique_ptr<int>>(results, n);
+    bench_element<std::string>(results, n);
+}
+
+}  // namespace alg::bench
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "bench_utility.hpp"
+#include "hash_map.hpp"
+
+namespace alg::bench {
+
+namespace {
+
+template <typename K>
+using AlgHashMap =
+    HashMap<K, size_t, Hash<K>, std::equal_to<>, BenchAllocator<std::pair<K, size_t>>>;
+template <typename K>
+using StdHashMap = std::unordered_map<K, size_t, std::hash<K>, std::equal_to<K>,
+                                      BenchAllocator<std::pair<const K, size_t>>>;
+
+template <typename K>
+K make_key(size_t i);
+template <>
+size_t make_key<size_t>(size_t i) {
+    return i * 0x9E3779B97F4A7C15ull;
+}
+template <>
+std::string make_key<std::string>(size_t i) {
+    return "session-" + std::to_string(i * 7919);
+}
+
+template <typename K>
+const char *key_name();
+template <>
+const char *key_name<size_t>() {
+    return "size_t";
+}
+template <>
+const char *key_name<std::string>() {
+    return "string";
+}
+
+template <typename M>
+void bench_map(std::vector<Result> &results, const char *container, size_t n) {
+    using K = typename M::key_type;
+    const char *element = key_name<K>();
+    std::vector<K> keys, missing;
+    for (size_t i = 0; i != n; ++i) keys.push_back(make_key<K>(i));
+    for (size_t i = 0; i != n; ++i) missing.push_back(make_key<K>(n + i));
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i != n; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    M m;
+    results.push_back(measure("hash", "insert", container, element, n, [&] {
+        for (size_t i = 0; i != n; ++i) m[keys[i]] = i;
+        keep(m.size());
+    }));
+    results.push_back(measure("hash", "find_hit", container, element, n, [&] {
+        size_t sum = 0;
+        for (size_t i : order) sum += m.find(keys[i])->second;
+        keep(sum);
+    }));
+    results.push_back(measure("hash", "find_miss", container, element, n, [&] {
+        size_t found = 0;
+        for (size_t i : order) found += m.find(missing[i]) != m.end();
+        keep(found);
+    }));
+    results.push_back(measure("hash", "erase_insert", container, element, n, [&] {
+        for (size_t i : order) {
+            m.erase(keys[i]);
+            m[missing[i]] = i;
+        }
+        keep(m.size());
+    }));
+}
+
+// string_view 查找: 本库直接查找, std::unordered_map (C++17) 需要先构造 std::string
+void bench_string_view(std::vector<Result> &results, size_t n) {
+    std::string text;
+    std::vector<std::pair<size_t, size_t>> spans;
+    for (size_t i = 0; i != n; ++i) {
+        std::string key = make_key<std::string>(i);
+        spans.emplace_back(text.size(), key.size());
+        text += key;
+    }
+    AlgHashMap<std::string> alg_map;
+    StdHashMap<std::string> std_map;
+    for (size_t i = 0; i != n; ++i) {
+        alg_map[make_key<std::string>(i)] = i;
+        std_map[make_key<std::string>(i)] = i;
+    }
+    std::string_view view = text;
+    results.push_back(measure("hash", "find_string_view", "alg::HashMap", "string", n, [&] {
+        size_t sum = 0;
+        for (auto &span : spans) sum += alg_map.find(view.substr(span.first, span.second))->second;
+        keep(sum);
+    }));
+    results.push_back(measure("hash", "find_string_view", "std::unordered_map", "string", n, [&] {
+        size_t sum = 0;
+        for (auto &span : spans) {
+            sum += std_map.find(std::string(view.substr(span.first, span.second)))->second;
+        }
+        keep(sum);
+    }));
+}
+
+}  // namespace
+
+void run_hash_benchmarks(std::vector<Result> &results, size_t n) {
+    bench_map<AlgHashMap<size_t>>(results, "alg::HashMap", n);
+    bench_map<StdHashMap<size_t>>(results, "std::unordered_map", n);
+    bench_map<AlgHashMap<std::string>>(results, "alg::HashMap", n);
+    bench_map<StdHashMap<std::string>>(results, "std::unordered_map", n);
+    bench_string_view(results, n);
+}
+
+}  // namespace alg::bench
@@ -0,0 +1,43 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bench_utility.hpp"
+
+namespace alg::bench {
+void run_container_benchmarks(std::vector<Result> &results, size_t n);
+void run_hash_benchmarks(std::vector<Result> &results, size_t n);
+void run_percolation_benchmarks(std::vector<Result> &results, size_t n);
+}  // namespace alg::bench
+
+// 用法: Algorithms.Bench [suite] [n]
+// suite 为 containers, hash, percolation 或 all (默认), n 为每个测试的元素个数
+// (percolation 中为网格的格点数); 结果以 JSON 输出到标准输出
+int main(int argc, char *argv[]) {
+    using namespace alg::bench;
+    const char *suite = argc > 1 ? argv[1] : "all";
+    size_t n = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+    bool all = std::strcmp(suite, "all") == 0;
+
+    bool known = all;
+    std::vector<Result> results;
+    if (all || std::strcmp(suite, "containers") == 0) {
+        run_container_benchmarks(results, n);
+        known = true;
+    }
+    if (all || std::strcmp(suite, "hash") == 0) {
+        run_hash_benchmarks(results, n);
+        known = true;
+    }
+    if (all || std::strcmp(suite, "percolation") == 0) {
+        run_percolation_benchmarks(results, n);
+        known = true;
+    }
+    if (!known) {
+        std::fprintf(stderr, "Unknown suite: %s\n", suite);
+        return 1;
+    }
+    print_json(stdout, results);
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "bench_utility.hpp"
+#include "percolation.hpp"
+#include "union_find/persistent_union_find.hpp"
+#include "union_find/quick_find.hpp"
+#include "union_find/quick_union.hpp"
+#include "union_find/rollback_union_find.hpp"
+
+namespace alg::bench {
+
+namespace {
+
+// 每个并查集跑同样的试验 (同一组种子), 阈值估计应当完全一致, 只有耗时不同
+template <typename TUnionFind>
+void bench_percolation(std::vector<Result> &results, const char *container, size_t side,
+                       size_t trials, size_t threads) {
+    PercolationStats stats = estimate_percolation<TUnionFind>(side, trials, threads);
+    Result r;
+    r.suite = "percolation";
+    r.name = "threshold";
+    r.container = container;
+    r.element = "site";
+    // n 取所有试验打开的格点数, ops_per_second 即每秒 open 次数
+    r.n = stats.opened;
+    r.seconds = stats.seconds;
+    r.extra.push_back({"side", static_cast<double>(side)});
+    r.extra.push_back({"trials", static_cast<double>(trials)});
+    r.extra.push_back({"threads", static_cast<double>(threads)});
+    r.extra.push_back({"threshold", stats.mean});
+    r.extra.push_back({"stddev", stats.stddev});
+    r.extra.push_back({"ci_low", stats.ci_low});
+    r.extra.push_back({"ci_high", stats.ci_high});
+    r.extra.push_back({"ns_per_open", stats.open_ns});
+    results.push_back(r);
+}
+
+}  // namespace
+
+// n 为格点总数, 网格边长取 sqrt(n); quick find 每次合并是线性的, 只在边长的 1/8 上运行
+void run_percolation_benchmarks(std::vector<Result> &results, size_t n) {
+    size_t side = std::max<size_t>(8, static_cast<size_t>(std::sqrt(static_cast<double>(n))));
+    size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t trials = std::max<size_t>(32, threads * 4);
+
+    bench_percolation<QuickUnion>(results, "QuickUnion", side, trials, threads);
+    bench_percolation<QuickUnion64>(results, "QuickUnion64", side, trials, threads);
+    bench_percolation<RollbackUnionFind>(results, "RollbackUnionFind", side, trials, threads);
+    bench_percolation<PersistentUnionFind>(results, "PersistentUnionFind", side, trials, threads);
+    bench_percolation<QuickFind>(results, "QuickFind", std::max<size_t>(8, side / 8), trials,
+                                 threads);
+    // 单线程的 quick union, 与上面比较可以看出并行的加速比
+    bench_percolation<QuickUnion>(results, "QuickUnion/1-thread", side, trials, 1);
+}
+
+}  // namespace alg::bench
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace alg {
+
+// 一个标签下所有分配的统计, 可以被多个线程同时更新
+class AllocStats {
+public:
+    using size_type = size_t;
+    static constexpr size_type BUCKETS = 48;
+
+    struct Snapshot {
+        std::string tag;
+        size_type allocations = 0;
+        size_type deallocations = 0;
+        size_type bytes_allocated = 0;  // 累计分配的字节数
+        size_type live_bytes = 0;
+        size_type peak_live_bytes = 0;
+        // histogram[k] 为字节数在 [2^k, 2^(k+1)) 之间的分配次数
+        // 按倍数扩容的容器每扩容一次就落入更高的一档, 可以看出扩容了多少次, 扩到了多大
+        std::array<size_type, BUCKETS> histogram{};
+    };
+
+public:
+    explicit AllocStats(std::string tag) : _tag(std::move(tag)) {}
+    AllocStats(const AllocStats &) = delete;
+    AllocStats &operator=(const AllocStats &) = delete;
+
+public:
+    // 同一个标签总是返回同一个对象, 对象在程序结束前一直有效
+    static AllocStats &for_tag(std::string_view tag);
+    // 所有标签的统计, 按标签排序
+    static std::vector<Snapshot> all();
+
+public:
+    void record_allocate(size_type bytes) noexcept;
+    void record_deallocate(size_type bytes) noexcept;
+    Snapshot snapshot() const;
+    // 清零计数, 仍然存活的字节数保留, 峰值从当前存活字节数重新开始
+    void reset() noexcept;
+    const std::string &tag() const noexcept { return _tag; }
+
+private:
+    std::string _tag;
+    std::atomic<size_type> _allocations{0};
+    std::atomic<size_type> _deallocations{0};
+    std::atomic<size_type> _bytes_allocated{0};
+    std::atomic<size_type> _live_bytes{0};
+    std::atomic<size_type> _peak_live_bytes{0};
+    std::array<std::atomic<size_type>, BUCKETS> _histogram{};
+};
+
+struct DefaultAllocTag {
+    static constexpr const char *name = "default";
+};
+
+// 包装任意分配器 A, 把经过它的分配记入 Tag::name 对应的 AllocStats
+// 本身不持有统计对象, 因此可以直接用于 ResizingArray, Vector 这类默认构造分配器的容器
+//
+//     struct CacheTag { static constexpr const char *name = "cache"; };
+//     Vector<int, StatsAllocator<int, CacheTag>> v;
+//     AllocStats::for_tag("cache").snapshot().peak_live_bytes;
+template <typename T, typename Tag = DefaultAllocTag, typename A = std::allocator<T>>
+class StatsAllocator {
+private:
+    using inner_type = typename std::allocator_traits<A>::template rebind_alloc<T>;
+    using inner_traits = std::allocator_traits<inner_type>;
+
+public:
+    using value_type = T;
+    using pointer = typename inner_traits::pointer;
+    using const_pointer = typename inner_traits::const_pointer;
+    using size_type = typename inner_traits::size_type;
+    using difference_type = typename inner_traits::difference_type;
+    using propagate_on_container_copy_assignment =
+        typename inner_traits::propagate_on_container_copy_assignment;
+    using propagate_on_container_move_assignment =
+        typename inner_traits::propagate_on_container_move_assignment;
+    using propagate_on_container_swap = typename inner_traits::propagate_on_container_swap;
+    using is_always_equal = typename inner_traits::is_always_equal;
+
+    template <typename U>
+    struct rebind {
+        using other = StatsAllocator<U, Tag, A>;
+    };
+
+public:
+    StatsAllocator() = default;
+    explicit StatsAllocator(const A &inner) : _inner(inner) {}
+    template <typename U>
+    StatsAllocator(const StatsAllocator<U, Tag, A> &rhs) noexcept : _inner(rhs.inner()) {}
+
+public:
+    pointer allocate(size_type n) {
+        pointer p = inner_traits::allocate(_inner, n);
+        stats().record_allocate(n * sizeof(T));
+        return p;
+    }
+    void deallocate(pointer p, size_type n) noexcept {
+        stats().record_deallocate(n * sizeof(T));
+        inner_traits::deallocate(_inner, p, n);
+    }
+
+public:
+    const inner_type &inner() const noexcept { return _inner; }
+    static AllocStats &stats() {
+        static AllocStats &s = AllocStats::for_tag(Tag::name);
+        return s;
+    }
+
+private:
+    inner_type _inner;
+};
+template <typename T, typename U, typename Tag, typename A>
+inline bool operator==(const StatsAllocator<T, Tag, A> &lhs, const StatsAllocator<U, Tag, A> &rhs) {
+    return lhs.inner() == rhs.inner();
+}
+template <typename T, typename U, typename Tag, typename A>
+inline bool operator!=(const StatsAllocator<T, Tag, A> &lhs, const StatsAllocator<U, Tag, A> &rhs) {
+    return !(lhs == rhs);
+}
+
+}  // namespace alg
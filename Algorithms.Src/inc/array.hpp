@@ -1,9 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 namespace alg {
 
@@ -40,13 +43,17 @@ struct Array {
     constexpr iterator begin() noexcept { return _data; }
     constexpr iterator end() noexcept { return _data + N; }
     constexpr const_iterator begin() const noexcept { return _data; }
-    constexpr const_iterator end() const noexcept { return N; }
+    constexpr const_iterator end() const noexcept { return _data + N; }
     constexpr const_iterator cbegin() const { return begin(); }
     constexpr const_iterator cend() const { return end() ; }
-    constexpr reverse_iterator rbegin() noexcept {return std::reverse_iterator(end() - 1)}
-    constexpr reverse_iterator rend() noexcept { return std::reverse_iterator(begin() - 1); }
-    constexpr const_reverse_iterator rbegin() const noexcept { return reverse_iterator(end() - 1); }
-    constexpr const_reverse_iterator rend() const noexcept { return reverse_iterator(begin() - 1); }
+    constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    constexpr const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    constexpr const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
     constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
     constexpr const_reverse_iterator crend() const noexcept { return rend(); }
 
@@ -0,0 +1,21 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ALG_X86 1
+#endif
+
+// GCC/Clang 需要为使用高级指令集的函数单独指定 target, MSVC 不需要
+#if defined(__GNUC__) || defined(__clang__)
+#define ALG_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ALG_TARGET(isa)
+#endif
+
+namespace alg::cpu {
+// 运行时检测 CPU 与操作系统是否支持对应指令集, 非 x86 平台均返回 false
+bool has_sse2() noexcept;
+bool has_ssse3() noexcept;
+bool has_avx2() noexcept;
+bool has_avx512f() noexcept;
+bool has_avx512bw() noexcept;
+}  // namespace alg::cpu
@@ -1,6 +1,40 @@
-#pragma once
+#pragma once
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace alg {
+
+// 预先解析好的表达式, 可以对整列数据批量求值
+// 表达式语法与 evaluate 相同, 额外允许以字母或 '_' 开头的变量名,
+// 变量按第一次出现的顺序编号, 见 variables()
+class Expression {
+public:
+    explicit Expression(const std::string &expr);
+
+public:
+    // vals[i] 为 variables()[i] 的值; 有变量时 vals 为空抛出 invalid_argument
+    double evaluate(const double *vals = nullptr) const;
+    // columns[i] 为 variables()[i] 的输入列, 每列 n 个元素, 结果写入 out[0, n)
+    void evaluate(const double *const *columns, size_t n, double *out) const;
+
+public:
+    const std::vector<std::string> &variables() const noexcept { return _vars; }
+
+private:
+    enum class OpCode : unsigned char { Const, Var, Add, Sub, Mul, Div, Sqrt };
+    struct Instruction {
+        OpCode op;
+        size_t index;  // Const: _consts 下标, Var: _vars 下标
+    };
+
+private:
+    std::vector<Instruction> _code;  // 后缀形式
+    std::vector<double> _consts;
+    std::vector<std::string> _vars;
+    size_t _max_depth = 0;
+};
+
 double evaluate(const std::string &expr);
-}
+
+}  // namespace alg
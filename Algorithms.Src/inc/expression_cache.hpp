@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "evaluation.hpp"
+
+namespace alg {
+
+// 以表达式文本为键缓存解析结果的 LRU 缓存, 可被多个线程同时使用
+// 键按哈希值分到若干个分片, 每个分片各自加锁并各自淘汰
+// 容量平均分给各分片, 余数分给前几个分片, 各分片容量之和等于 capacity
+class ExpressionCache {
+public:
+    using size_type = size_t;
+    using value_type = std::shared_ptr<const Expression>;
+
+public:
+    explicit ExpressionCache(size_type capacity, size_type shards = 16);
+    ExpressionCache(const ExpressionCache &) = delete;
+    ExpressionCache &operator=(const ExpressionCache &) = delete;
+
+public:
+    // 命中时只需一次哈希查找, 未命中时在锁外解析后再放入缓存
+    value_type get(std::string_view expr);
+    double evaluate(std::string_view expr, const double *vals = nullptr);
+    void clear();
+
+public:
+    size_type size() const;
+    size_type capacity() const noexcept { return _capacity; }
+    size_type hits() const noexcept { return _hits.load(std::memory_order_relaxed); }
+    size_type misses() const noexcept { return _misses.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        std::string text;  // 键的唯一一份拷贝, 索引中的 string_view 指向这里
+        size_t hash;
+        value_type expr;
+    };
+    struct Key {
+        std::string_view text;
+        size_t hash;
+        bool operator==(const Key &rhs) const { return text == rhs.text; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key &key) const noexcept { return key.hash; }
+    };
+    struct Shard {
+        size_type capacity;
+        std::mutex mutex;
+        std::list<Entry> lru;  // 最近使用的在前
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    };
+
+private:
+    Shard &shard_of(size_t hash) { return *_shards[hash % _shards.size()]; }
+
+private:
+    std::vector<std::unique_ptr<Shard>> _shards;
+    size_type _capacity;
+    std::atomic<size_type> _hits{0};
+    std::atomic<size_type> _misses{0};
+};
+
+}  // namespace alg
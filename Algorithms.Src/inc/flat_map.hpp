@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "search/binary_search.hpp"
+#include "vector.hpp"
+
+namespace alg {
+
+// 按键稳定排序后的下标, 相等的键只保留第一次出现的那个
+template <typename K, typename TComparer>
+Vector<size_t> __sorted_unique_order(const Vector<K> &keys, TComparer comp) {
+    Vector<size_t> order;
+    order.reserve(keys.size());
+    for (size_t i = 0; i != keys.size(); ++i) order.push_back(i);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t lhs, size_t rhs) { return comp(keys[lhs], keys[rhs]); });
+    auto last = std::unique(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return !comp(keys[lhs], keys[rhs]);
+    });
+    order.erase(last, order.end());
+    return order;
+}
+template <typename T>
+Vector<T> __gather(Vector<T> &src, const Vector<size_t> &order) {
+    Vector<T> result;
+    result.reserve(order.size());
+    for (size_t i : order) result.push_back(std::move(src[i]));
+    return result;
+}
+// keys 中哪些键 (下标记入 picks) 不在有序的 sorted 中, 以及它们在 sorted 中的插入位置
+// keys 已按 order 有序, 所以每次只需在上一个位置之后查找
+template <typename K, typename TComparer>
+void __merge_positions(const Vector<K> &sorted, const Vector<K> &keys, const Vector<size_t> &order,
+                       TComparer comp, Vector<size_t> &positions, Vector<size_t> &picks) {
+    auto from = sorted.begin();
+    for (size_t i : order) {
+        from = alg::lower_bound(from, sorted.end(), keys[i], comp);
+        if (from != sorted.end() && !comp(keys[i], *from)) continue;
+        positions.push_back(from - sorted.begin());
+        picks.push_back(i);
+    }
+}
+
+// 有序数组实现的集合, 元素连续存放, 适合读多写少的场景
+// 单个插入和删除为 O(n), 批量插入先排序去重再一次合并
+template <typename K, typename TComparer = std::less<K>>
+class FlatSet {
+public:
+    using key_type = K;
+    using value_type = K;
+    using key_compare = TComparer;
+    using size_type = size_t;
+    using const_iterator = typename Vector<K>::const_iterator;
+    using iterator = const_iterator;
+
+public:
+    FlatSet() = default;
+    explicit FlatSet(TComparer comp) : _comp(comp) {}
+    // 批量构造: 排序并去重一次
+    explicit FlatSet(Vector<K> keys, TComparer comp = TComparer()) : _comp(comp) {
+        _keys = __gather(keys, __sorted_unique_order(keys, _comp));
+    }
+    template <typename InputIt>
+    FlatSet(InputIt first, InputIt last, TComparer comp = TComparer()) : _comp(comp) {
+        insert(first, last);
+    }
+    FlatSet(std::initializer_list<K> keys, TComparer comp = TComparer())
+        : FlatSet(Vector<K>(keys), comp) {}
+
+public:
+    bool insert(const K &key) {
+        const_iterator pos = lower_bound(key);
+        if (pos != end() && !_comp(key, *pos)) return false;
+        _keys.insert(pos, key);
+        return true;
+    }
+    // 批量插入, 每个已有元素最多移动一次
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        Vector<K> keys;
+        keys.insert(keys.end(), first, last);
+        Vector<size_t> positions, picks;
+        __merge_positions(_keys, keys, __sorted_unique_order(keys, _comp), _comp, positions,
+                          picks);
+        Vector<K> picked = __gather(keys, picks);
+        _keys.insert_at(positions.begin(), positions.end(),
+                        std::make_move_iterator(picked.begin()));
+    }
+    bool erase(const K &key) {
+        const_iterator pos = find(key);
+        if (pos == end()) return false;
+        _keys.erase(pos);
+        return true;
+    }
+    void clear() { _keys.clear(); }
+    void reserve(size_type n) { _keys.reserve(n); }
+
+public:
+    const_iterator lower_bound(const K &key) const {
+        return alg::lower_bound(_keys.begin(), _keys.end(), key, _comp);
+    }
+    const_iterator find(const K &key) const {
+        const_iterator pos = lower_bound(key);
+        return pos != end() && !_comp(key, *pos) ? pos : end();
+    }
+    bool contains(const K &key) const { return find(key) != end(); }
+
+    const_iterator begin() const noexcept { return _keys.begin(); }
+    const_iterator end() const noexcept { return _keys.end(); }
+    const Vector<K> &keys() const noexcept { return _keys; }
+    size_type size() const noexcept { return _keys.size(); }
+    bool empty() const noexcept { return _keys.empty(); }
+    key_compare key_comp() const { return _comp; }
+
+private:
+    Vector<K> _keys;
+    TComparer _comp;
+};
+
+// 有序数组实现的映射, 键和值分别存放在两个 Vector 中, 查找时只访问键
+template <typename K, typename V, typename TComparer = std::less<K>>
+class FlatMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using key_compare = TComparer;
+    using size_type = size_t;
+
+public:
+    FlatMap() = default;
+    explicit FlatMap(TComparer comp) : _comp(comp) {}
+    // 批量构造: 排序并去重一次, 重复的键保留第一次出现的值
+    FlatMap(Vector<K> keys, Vector<V> values, TComparer comp = TComparer()) : _comp(comp) {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values must have the same size.");
+        }
+        Vector<size_t> order = __sorted_unique_order(keys, _comp);
+        _keys = __gather(keys, order);
+        _values = __gather(values, order);
+    }
+    template <typename InputIt>
+    FlatMap(InputIt first, InputIt last, TComparer comp = TComparer()) : _comp(comp) {
+        insert(first, last);
+    }
+    FlatMap(std::initializer_list<std::pair<K, V>> items, TComparer comp = TComparer())
+        : FlatMap(items.begin(), items.end(), comp) {}
+
+public:
+    // 键已存在时不修改, 返回 false
+    bool insert(const K &key, V value) {
+        size_type idx = lower_index(key);
+        if (idx != size() && !_comp(key, _keys[idx])) return false;
+        _keys.insert(_keys.begin() + idx, key);
+        _values.insert(_values.begin() + idx, std::move(value));
+        return true;
+    }
+    // 键已存在时覆盖, 返回是否新插入
+    bool insert_or_assign(const K &key, V value) {
+        size_type idx = lower_index(key);
+        if (idx != size() && !_comp(key, _keys[idx])) {
+            _values[idx] = std::move(value);
+            return false;
+        }
+        _keys.insert(_keys.begin() + idx, key);
+        _values.insert(_values.begin() + idx, std::move(value));
+        return true;
+    }
+    // 批量插入 std::pair<K, V>, 已存在的键保持原值; 每个已有元素最多移动一次
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        Vector<K> keys;
+        Vector<V> values;
+        for (; first != last; ++first) {
+            keys.push_back(first->first);
+            values.push_back(first->second);
+        }
+        insert(std::move(keys), std::move(values));
+    }
+    void insert(Vector<K> keys, Vector<V> values) {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values must have the same size.");
+        }
+        Vector<size_t> positions, picks;
+        __merge_positions(_keys, keys, __sorted_unique_order(keys, _comp), _comp, positions,
+                          picks);
+        Vector<K> picked_keys = __gather(keys, picks);
+        Vector<V> picked_values = __gather(values, picks);
+        _keys.insert_at(positions.begin(), positions.end(),
+                        std::make_move_iterator(picked_keys.begin()));
+        _values.insert_at(positions.begin(), positions.end(),
+                          std::make_move_iterator(picked_values.begin()));
+    }
+    bool erase(const K &key) {
+        size_type idx = index_of(key);
+        if (idx == npos) return false;
+        _keys.erase(_keys.begin() + idx);
+        _values.erase(_values.begin() + idx);
+        return true;
+    }
+    void clear() {
+        _keys.clear();
+        _values.clear();
+    }
+    void reserve(size_type n) {
+        _keys.reserve(n);
+        _values.reserve(n);
+    }
+
+public:
+    // 不存在时插入默认值
+    V &operator[](const K &key) {
+        size_type idx = lower_index(key);
+        if (idx == size() || _comp(key, _keys[idx])) {
+            _keys.insert(_keys.begin() + idx, key);
+            _values.insert(_values.begin() + idx, V());
+        }
+        return _values[idx];
+    }
+    V &at(const K &key) {
+        return const_cast<V &>(static_cast<const FlatMap &>(*this).at(key));
+    }
+    const V &at(const K &key) const {
+        size_type idx = index_of(key);
+        if (idx == npos) throw std::out_of_range("Key not found.");
+        return _values[idx];
+    }
+    // 不存在时返回空指针
+    V *find(const K &key) {
+        return const_cast<V *>(static_cast<const FlatMap &>(*this).find(key));
+    }
+    const V *find(const K &key) const {
+        size_type idx = index_of(key);
+        return idx == npos ? nullptr : &_values[idx];
+    }
+    bool contains(const K &key) const { return index_of(key) != npos; }
+    // 键的下标, 不存在时返回 npos
+    size_type index_of(const K &key) const {
+        size_type idx = lower_index(key);
+        return idx != size() && !_comp(key, _keys[idx]) ? idx : npos;
+    }
+
+    const K &key_at(size_type idx) const { return _keys.at(idx); }
+    V &value_at(size_type idx) { return _values.at(idx); }
+    const V &value_at(size_type idx) const { return _values.at(idx); }
+    const Vector<K> &keys() const noexcept { return _keys; }
+    const Vector<V> &values() const noexcept { return _values; }
+    size_type size() const noexcept { return _keys.size(); }
+    bool empty() const noexcept { return _keys.empty(); }
+    key_compare key_comp() const { return _comp; }
+
+public:
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    size_type lower_index(const K &key) const {
+        return alg::lower_bound(_keys.begin(), _keys.end(), key, _comp) - _keys.begin();
+    }
+
+private:
+    Vector<K> _keys;
+    Vector<V> _values;
+    TComparer _comp;
+};
+
+}  // namespace alg
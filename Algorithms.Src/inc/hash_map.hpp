@@ -0,0 +1,476 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// SSE2 是 x86-64 的基本指令集, 探测代码必须内联, 所以这里按编译选项选择而不是运行时分派
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ALG_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace alg {
+
+// 默认的哈希函数, std::string 为键时可以直接用 string_view 或 const char * 查找
+template <typename K>
+struct Hash {
+    size_t operator()(const K &key) const { return std::hash<K>()(key); }
+};
+template <>
+struct Hash<std::string> {
+    using is_transparent = void;
+    size_t operator()(std::string_view key) const { return std::hash<std::string_view>()(key); }
+};
+
+namespace swiss {
+
+// 控制字节: 0 ~ 127 表示占用 (存哈希值的低 7 位), 负数表示空或已删除
+using ctrl_t = signed char;
+constexpr ctrl_t EMPTY = -128;
+constexpr ctrl_t DELETED = -2;
+constexpr size_t GROUP = 16;
+
+inline unsigned trailing_zeros(std::uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return idx;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+// 16 位掩码的前导零个数, mask 不为 0
+inline unsigned leading_zeros16(std::uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanReverse(&idx, mask);
+    return 15 - idx;
+#else
+    return __builtin_clz(mask) - 16;
+#endif
+}
+
+// 从任意位置开始的 16 个控制字节, match 系列返回 16 位掩码
+struct Group {
+#if defined(ALG_HASH_SSE2)
+    explicit Group(const ctrl_t *p)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {}
+
+    std::uint32_t match(ctrl_t h2) const {
+        return static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+    }
+    std::uint32_t match_empty_or_deleted() const {
+        return static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+    }
+
+    __m128i ctrl;
+#else
+    explicit Group(const ctrl_t *p) { std::memcpy(ctrl, p, GROUP); }
+
+    std::uint32_t match(ctrl_t h2) const {
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i != GROUP; ++i) mask |= std::uint32_t(ctrl[i] == h2) << i;
+        return mask;
+    }
+    std::uint32_t match_empty_or_deleted() const {
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i != GROUP; ++i) mask |= std::uint32_t(ctrl[i] < -1) << i;
+        return mask;
+    }
+
+    ctrl_t ctrl[GROUP];
+#endif
+    std::uint32_t match_empty() const { return match(EMPTY); }
+};
+
+// std::hash 对整数通常直接返回原值, 先打散再分成 h1 (定位) 和 h2 (控制字节)
+inline size_t mix(size_t h) {
+    std::uint64_t x = static_cast<std::uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(x ^ (x >> 32));
+}
+
+}  // namespace swiss
+
+// 开放寻址的哈希表 (Swiss table): 控制字节与槽分开存放, 每次用 SSE2 比较 16 个控制字节,
+// 只有哈希值低 7 位相同的槽才需要比较键. 最大负载为 7/8, 容量为 2 的幂
+// 删除时如果所在位置从未使探测序列越过满组, 直接标记为空而不留下墓碑
+// 键和值以 std::pair<K, V> 存放在槽中, 不要通过迭代器修改键
+template <typename K, typename V, typename THash = Hash<K>, typename TEqual = std::equal_to<>,
+          typename A = std::allocator<std::pair<K, V>>>
+class HashMap {
+private:
+    using ctrl_t = swiss::ctrl_t;
+    using slot_alloc = typename std::allocator_traits<A>::template rebind_alloc<std::pair<K, V>>;
+    using slot_traits = std::allocator_traits<slot_alloc>;
+    using ctrl_alloc = typename std::allocator_traits<A>::template rebind_alloc<ctrl_t>;
+    using ctrl_traits = std::allocator_traits<ctrl_alloc>;
+    static constexpr size_t GROUP = swiss::GROUP;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using hasher = THash;
+    using key_equal = TEqual;
+    using allocator_type = A;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+
+private:
+    template <bool Const>
+    class Iter {
+        friend class HashMap;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<K, V>;
+        using difference_type = ptrdiff_t;
+        using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+        using reference = std::conditional_t<Const, const value_type &, value_type &>;
+
+    public:
+        Iter() = default;
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Iter(const Iter<false> &rhs) : _ctrl(rhs._ctrl), _slot(rhs._slot), _end(rhs._end) {}
+
+        reference operator*() const { return *_slot; }
+        pointer operator->() const { return _slot; }
+        Iter &operator++() {
+            ++_ctrl;
+            ++_slot;
+            skip_free();
+            return *this;
+        }
+        Iter operator++(int) {
+            Iter tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        friend bool operator==(const Iter &lhs, const Iter &rhs) { return lhs._slot == rhs._slot; }
+        friend bool operator!=(const Iter &lhs, const Iter &rhs) { return lhs._slot != rhs._slot; }
+
+    private:
+        Iter(const ctrl_t *ctrl, pointer slot, const ctrl_t *end)
+            : _ctrl(ctrl), _slot(slot), _end(end) {}
+        void skip_free() {
+            while (_ctrl != _end && *_ctrl < 0) {
+                ++_ctrl;
+                ++_slot;
+            }
+        }
+
+    private:
+        template <bool>
+        friend class Iter;
+        const ctrl_t *_ctrl = nullptr;
+        pointer _slot = nullptr;
+        const ctrl_t *_end = nullptr;
+    };
+
+public:
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+
+public:
+    HashMap() = default;
+    explicit HashMap(size_type n) { reserve(n); }
+    HashMap(std::initializer_list<value_type> vals) {
+        reserve(vals.size());
+        for (auto &v : vals) insert(v);
+    }
+    HashMap(const HashMap &rhs) : _hash(rhs._hash), _eq(rhs._eq), _alloc(rhs._alloc) {
+        reserve(rhs.size());
+        for (auto &v : rhs) insert(v);
+    }
+    HashMap(HashMap &&rhs) noexcept { swap(rhs); }
+    ~HashMap() {
+        destroy_slots();
+        release(_ctrl, _slots, _capacity);
+    }
+
+public:
+    HashMap &operator=(const HashMap &rhs) {
+        if (std::addressof(rhs) == this) return *this;
+        HashMap tmp(rhs);
+        swap(tmp);
+        return *this;
+    }
+    HashMap &operator=(HashMap &&rhs) noexcept {
+        if (std::addressof(rhs) == this) return *this;
+        HashMap tmp(std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+    V &operator[](const K &key) { return try_emplace(key).first->second; }
+    V &operator[](K &&key) { return try_emplace(std::move(key)).first->second; }
+
+public:
+    // 键不存在时用 args 构造值, 存在时什么也不做
+    template <typename Q, typename... TArgs>
+    std::pair<iterator, bool> try_emplace(Q &&key, TArgs &&... args) {
+        size_t h = hash_of(key);
+        size_type i = find_index(key, h);
+        if (i != npos) return {iter_at(i), false};
+        i = prepare_insert(h);
+        slot_traits::construct(_alloc, _slots + i, std::piecewise_construct,
+                               std::forward_as_tuple(std::forward<Q>(key)),
+                               std::forward_as_tuple(std::forward<TArgs>(args)...));
+        commit_insert(i, h);
+        return {iter_at(i), true};
+    }
+    std::pair<iterator, bool> insert(const value_type &val) {
+        return try_emplace(val.first, val.second);
+    }
+    std::pair<iterator, bool> insert(value_type &&val) {
+        return try_emplace(std::move(val.first), std::move(val.second));
+    }
+    template <typename Q, typename M>
+    std::pair<iterator, bool> insert_or_assign(Q &&key, M &&val) {
+        auto result = try_emplace(std::forward<Q>(key), std::forward<M>(val));
+        if (!result.second) result.first->second = std::forward<M>(val);
+        return result;
+    }
+
+    template <typename Q>
+    size_type erase(const Q &key) {
+        size_type i = find_index(key, hash_of(key));
+        if (i == npos) return 0;
+        erase_at(i);
+        return 1;
+    }
+    iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+    iterator erase(const_iterator pos) {
+        size_type i = pos._slot - _slots;
+        erase_at(i);
+        iterator next(_ctrl + i, _slots + i, _ctrl + _capacity);
+        next.skip_free();
+        return next;
+    }
+    void clear() {
+        destroy_slots();
+        // reset_ctrl 按 _size 计算剩余的插入额度, 必须先清零
+        _size = 0;
+        if (_capacity != 0) reset_ctrl();
+    }
+    // 保证插入 n 个元素之前不会再扩容
+    void reserve(size_type n) {
+        if (n > max_load(_capacity)) rehash(capacity_for(n));
+    }
+    void swap(HashMap &rhs) noexcept {
+        using std::swap;
+        swap(_ctrl, rhs._ctrl);
+        swap(_slots, rhs._slots);
+        swap(_capacity, rhs._capacity);
+        swap(_size, rhs._size);
+        swap(_growth_left, rhs._growth_left);
+        swap(_hash, rhs._hash);
+        swap(_eq, rhs._eq);
+        swap(_alloc, rhs._alloc);
+    }
+
+public:
+    template <typename Q>
+    iterator find(const Q &key) {
+        size_type i = find_index(key, hash_of(key));
+        return i == npos ? end() : iter_at(i);
+    }
+    template <typename Q>
+    const_iterator find(const Q &key) const {
+        return const_cast<HashMap &>(*this).find(key);
+    }
+    template <typename Q>
+    bool contains(const Q &key) const {
+        return find_index(key, hash_of(key)) != npos;
+    }
+    template <typename Q>
+    size_type count(const Q &key) const {
+        return contains(key) ? 1 : 0;
+    }
+    template <typename Q>
+    V &at(const Q &key) {
+        size_type i = find_index(key, hash_of(key));
+        if (i == npos) throw std::out_of_range("Key not found.");
+        return _slots[i].second;
+    }
+    template <typename Q>
+    const V &at(const Q &key) const {
+        return const_cast<HashMap &>(*this).at(key);
+    }
+
+    iterator begin() noexcept {
+        iterator iter(_ctrl, _slots, _ctrl + _capacity);
+        iter.skip_free();
+        return iter;
+    }
+    iterator end() noexcept {
+        return iterator(_ctrl + _capacity, _slots + _capacity, _ctrl + _capacity);
+    }
+    const_iterator begin() const noexcept { return const_cast<HashMap &>(*this).begin(); }
+    const_iterator end() const noexcept { return const_cast<HashMap &>(*this).end(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_type size() const noexcept { return _size; }
+    bool empty() const noexcept { return _size == 0; }
+    size_type capacity() const noexcept { return _capacity; }
+    double load_factor() const noexcept { return _capacity == 0 ? 0 : double(_size) / _capacity; }
+    allocator_type get_allocator() const noexcept { return _alloc; }
+
+private:
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    static size_type max_load(size_type capacity) noexcept { return capacity - capacity / 8; }
+    static size_type capacity_for(size_type n) noexcept {
+        size_type capacity = GROUP;
+        while (max_load(capacity) < n) capacity *= 2;
+        return capacity;
+    }
+
+    template <typename Q>
+    size_t hash_of(const Q &key) const {
+        return swiss::mix(_hash(key));
+    }
+
+    template <typename Q>
+    size_type find_index(const Q &key, size_t h) const {
+        if (_size == 0) return npos;
+        ctrl_t h2 = static_cast<ctrl_t>(h & 0x7F);
+        size_type mask = _capacity - 1, pos = (h >> 7) & mask;
+        for (size_type step = GROUP;; step += GROUP) {
+            swiss::Group g(_ctrl + pos);
+            for (std::uint32_t m = g.match(h2); m != 0; m &= m - 1) {
+                size_type i = (pos + swiss::trailing_zeros(m)) & mask;
+                if (_eq(_slots[i].first, key)) return i;
+            }
+            if (g.match_empty()) return npos;
+            pos = (pos + step) & mask;
+        }
+    }
+    // 探测序列上第一个空或已删除的槽; 按组三角数步长探测, 容量为 2 的幂时能走遍所有组
+    size_type find_free(size_t h) const {
+        size_type mask = _capacity - 1, pos = (h >> 7) & mask;
+        for (size_type step = GROUP;; step += GROUP) {
+            std::uint32_t m = swiss::Group(_ctrl + pos).match_empty_or_deleted();
+            if (m != 0) return (pos + swiss::trailing_zeros(m)) & mask;
+            pos = (pos + step) & mask;
+        }
+    }
+    // 找到写入新元素的槽, 必要时先扩容或原地清理墓碑
+    size_type prepare_insert(size_t h) {
+        if (_capacity == 0) rehash(capacity_for(1));
+        size_type i = find_free(h);
+        if (_growth_left == 0 && _ctrl[i] == swiss::EMPTY) {
+            // 大量位置被墓碑占用时以原容量重建即可
+            rehash(_size * 16 <= _capacity * 7 ? _capacity : _capacity * 2);
+            i = find_free(h);
+        }
+        return i;
+    }
+    void commit_insert(size_type i, size_t h) {
+        _growth_left -= _ctrl[i] == swiss::EMPTY;
+        set_ctrl(i, static_cast<ctrl_t>(h & 0x7F));
+        ++_size;
+    }
+    void erase_at(size_type i) {
+        slot_traits::destroy(_alloc, _slots + i);
+        --_size;
+        // 前后两组里都有空位, 并且 i 附近连续的满位不足一组时, 没有探测序列会越过 i 继续向后,
+        // 可以直接置空
+        size_type before = (i - GROUP) & (_capacity - 1);
+        std::uint32_t empty_after = swiss::Group(_ctrl + i).match_empty();
+        std::uint32_t empty_before = swiss::Group(_ctrl + before).match_empty();
+        bool never_full = false;
+        if (empty_before != 0 && empty_after != 0) {
+            size_type run = swiss::trailing_zeros(empty_after) + swiss::leading_zeros16(empty_before);
+            never_full = run < GROUP;
+        }
+        set_ctrl(i, never_full ? swiss::EMPTY : swiss::DELETED);
+        _growth_left += never_full;
+    }
+    // 末尾多出 GROUP - 1 个字节, 复制开头的控制字节, 从任意位置读一组都不用回绕
+    void set_ctrl(size_type i, ctrl_t c) noexcept {
+        _ctrl[i] = c;
+        if (i < GROUP - 1) _ctrl[_capacity + i] = c;
+    }
+    void reset_ctrl() noexcept {
+        std::memset(_ctrl, static_cast<unsigned char>(swiss::EMPTY), _capacity + GROUP - 1);
+        _growth_left = max_load(_capacity) - _size;
+    }
+
+    void rehash(size_type capacity) {
+        ctrl_alloc calloc(_alloc);
+        ctrl_t *old_ctrl = _ctrl;
+        value_type *old_slots = _slots;
+        size_type old_capacity = _capacity;
+
+        _ctrl = ctrl_traits::allocate(calloc, capacity + GROUP - 1);
+        try {
+            _slots = slot_traits::allocate(_alloc, capacity);
+        } catch (...) {
+            ctrl_traits::deallocate(calloc, _ctrl, capacity + GROUP - 1);
+            _ctrl = old_ctrl;
+            throw;
+        }
+        _capacity = capacity;
+        reset_ctrl();
+        for (size_type j = 0; j != old_capacity; ++j) {
+            if (old_ctrl[j] < 0) continue;
+            size_t h = hash_of(old_slots[j].first);
+            size_type i = find_free(h);
+            slot_traits::construct(_alloc, _slots + i, std::move(old_slots[j]));
+            slot_traits::destroy(_alloc, old_slots + j);
+            set_ctrl(i, static_cast<ctrl_t>(h & 0x7F));
+        }
+        _growth_left = max_load(_capacity) - _size;
+        release(old_ctrl, old_slots, old_capacity);
+    }
+    void destroy_slots() noexcept {
+        for (size_type i = 0; i != _capacity; ++i) {
+            if (_ctrl[i] >= 0) slot_traits::destroy(_alloc, _slots + i);
+        }
+    }
+    void release(ctrl_t *ctrl, value_type *slots, size_type capacity) noexcept {
+        if (capacity == 0) return;
+        ctrl_alloc calloc(_alloc);
+        ctrl_traits::deallocate(calloc, ctrl, capacity + GROUP - 1);
+        slot_traits::deallocate(_alloc, slots, capacity);
+    }
+    iterator iter_at(size_type i) noexcept {
+        return iterator(_ctrl + i, _slots + i, _ctrl + _capacity);
+    }
+
+private:
+    ctrl_t *_ctrl = nullptr;
+    value_type *_slots = nullptr;
+    size_type _capacity = 0;
+    size_type _size = 0;
+    size_type _growth_left = 0;
+    THash _hash;
+    TEqual _eq;
+    slot_alloc _alloc;
+};
+
+template <typename K, typename V, typename H, typename E, typename A>
+inline void swap(HashMap<K, V, H, E, A> &x, HashMap<K, V, H, E, A> &y) {
+    x.swap(y);
+}
+
+}  // namespace alg
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace alg {
+
+namespace huge_pages {
+constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+// 不小于一个大页的分配按大页对齐, 并请求操作系统用大页映射 (Linux 为透明大页,
+// Windows 在进程有 SeLockMemoryPrivilege 权限时使用 MEM_LARGE_PAGES, 否则退回普通页);
+// 较小的分配直接使用 operator new. 失败时抛出 std::bad_alloc
+void *allocate(size_t bytes);
+void deallocate(void *p, size_t bytes) noexcept;
+}  // namespace huge_pages
+
+// 大数组 (例如十亿节点的并查集) 用大页可以大幅减少 TLB 缺失
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+public:
+    HugePageAllocator() noexcept = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U> &) noexcept {}
+
+public:
+    T *allocate(size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T *>(huge_pages::allocate(n * sizeof(T)));
+    }
+    void deallocate(T *p, size_t n) noexcept { huge_pages::deallocate(p, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+inline bool operator==(const HugePageAllocator<T> &, const HugePageAllocator<U> &) noexcept {
+    return true;
+}
+template <typename T, typename U>
+inline bool operator!=(const HugePageAllocator<T> &, const HugePageAllocator<U> &) noexcept {
+    return false;
+}
+
+}  // namespace alg
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace alg {
+
+// 一次或多次调用中发生的元素操作次数
+struct OpCounts {
+    size_t comparisons = 0;
+    size_t swaps = 0;
+    size_t moves = 0;
+    size_t copies = 0;
+};
+
+namespace instrument {
+// 当前线程上正在记录的计数, 没有 CountOps 作用域时为空
+inline thread_local OpCounts *current = nullptr;
+
+inline void count(size_t OpCounts::*field) noexcept {
+    if (current) ++(current->*field);
+}
+}  // namespace instrument
+
+// 作用域内, 当前线程上 Counted 元素和 CountingComparer 的操作都记入 counts, 可以嵌套
+// 计数完全由元素类型和比较器类型触发, 普通类型和比较器不受任何影响
+//
+//     OpCounts counts;
+//     {
+//         CountOps scope(counts);
+//         quick_sort(arr.begin(), arr.end());  // arr 的元素为 Counted<T>
+//     }
+class CountOps {
+public:
+    explicit CountOps(OpCounts &counts) noexcept : _prev(instrument::current) {
+        instrument::current = &counts;
+    }
+    CountOps(const CountOps &) = delete;
+    CountOps &operator=(const CountOps &) = delete;
+    ~CountOps() { instrument::current = _prev; }
+
+private:
+    OpCounts *_prev;
+};
+
+// 记录复制, 移动, 交换和比较次数的元素包装
+template <typename T>
+class Counted {
+public:
+    Counted() = default;
+    Counted(const T &value) : _value(value) {}
+    Counted(const Counted &rhs) : _value(rhs._value) { instrument::count(&OpCounts::copies); }
+    Counted(Counted &&rhs) noexcept : _value(std::move(rhs._value)) {
+        instrument::count(&OpCounts::moves);
+    }
+
+public:
+    Counted &operator=(const Counted &rhs) {
+        _value = rhs._value;
+        instrument::count(&OpCounts::copies);
+        return *this;
+    }
+    Counted &operator=(Counted &&rhs) noexcept {
+        _value = std::move(rhs._value);
+        instrument::count(&OpCounts::moves);
+        return *this;
+    }
+
+public:
+    const T &value() const noexcept { return _value; }
+
+    friend void swap(Counted &lhs, Counted &rhs) noexcept {
+        using std::swap;
+        swap(lhs._value, rhs._value);
+        instrument::count(&OpCounts::swaps);
+    }
+    friend bool operator<(const Counted &lhs, const Counted &rhs) {
+        instrument::count(&OpCounts::comparisons);
+        return lhs._value < rhs._value;
+    }
+    friend bool operator>(const Counted &lhs, const Counted &rhs) {
+        instrument::count(&OpCounts::comparisons);
+        return rhs._value < lhs._value;
+    }
+    friend bool operator<=(const Counted &lhs, const Counted &rhs) {
+        instrument::count(&OpCounts::comparisons);
+        return !(rhs._value < lhs._value);
+    }
+    friend bool operator>=(const Counted &lhs, const Counted &rhs) {
+        instrument::count(&OpCounts::comparisons);
+        return !(lhs._value < rhs._value);
+    }
+    friend bool operator==(const Counted &lhs, const Counted &rhs) {
+        instrument::count(&OpCounts::comparisons);
+        return lhs._value == rhs._value;
+    }
+    friend bool operator!=(const Counted &lhs, const Counted &rhs) { return !(lhs == rhs); }
+
+private:
+    T _value{};
+};
+
+// 记录调用次数的比较器包装, 用于不方便替换元素类型的场合
+template <typename TComparer>
+struct CountingComparer {
+    TComparer comp;
+
+    template <typename T, typename U>
+    bool operator()(const T &lhs, const U &rhs) const {
+        instrument::count(&OpCounts::comparisons);
+        return comp(lhs, rhs);
+    }
+};
+template <typename TComparer>
+inline CountingComparer<TComparer> counting(TComparer comp) {
+    return CountingComparer<TComparer>{comp};
+}
+
+}  // namespace alg
@@ -1,22 +1,368 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
+
 namespace alg {
 
-template<typename T, typename A = std::allocator<T>>
+// 带哨兵的循环双向链表
+template <typename T, typename A = std::allocator<T>>
 class List {
-public:
 private:
-    struct Node {
-        Node *prev;
-        Node *next;
+    struct NodeBase {
+        NodeBase *prev;
+        NodeBase *next;
+    };
+    struct Node : NodeBase {
         T data;
     };
+    using node_allocator = typename std::allocator_traits<A>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    template <bool Const>
+    class Iter {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const T &, T &>;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+
+    public:
+        Iter() = default;
+        explicit Iter(NodeBase *node) : _node(node) {}
+        operator Iter<true>() const { return Iter<true>(_node); }
+
+        reference operator*() const { return static_cast<Node *>(_node)->data; }
+        pointer operator->() const { return std::addressof(**this); }
+        Iter &operator++() {
+            _node = _node->next;
+            return *this;
+        }
+        Iter &operator--() {
+            _node = _node->prev;
+            return *this;
+        }
+        Iter operator++(int) {
+            Iter old = *this;
+            ++*this;
+            return old;
+        }
+        Iter operator--(int) {
+            Iter old = *this;
+            --*this;
+            return old;
+        }
+        friend bool operator==(const Iter &lhs, const Iter &rhs) { return lhs._node == rhs._node; }
+        friend bool operator!=(const Iter &lhs, const Iter &rhs) { return lhs._node != rhs._node; }
+
+    private:
+        NodeBase *_node = nullptr;
+        friend class List;
+    };
+
+public:
+    using allocator_type = A;
+    using value_type = T;
+    using size_type = size_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+public:
+    List() { reset(); }
+    explicit List(const A &alloc) : _alloc(alloc) { reset(); }
+    template <typename InputIt>
+    List(InputIt first, InputIt last) : List() {
+        for (; first != last; ++first) push_back(*first);
+    }
+    List(std::initializer_list<value_type> vals) : List(vals.begin(), vals.end()) {}
+    List(const List &rhs)
+        : _alloc(node_traits::select_on_container_copy_construction(rhs._alloc)) {
+        reset();
+        for (const auto &v : rhs) push_back(v);
+    }
+    List(List &&rhs) noexcept : _alloc(std::move(rhs._alloc)) {
+        reset();
+        take(rhs);
+    }
+    ~List() { clear(); }
+
 public:
-    List();
-    ~List();
+    List &operator=(const List &rhs) {
+        if (std::addressof(rhs) == this) return *this;
+        List tmp(rhs);
+        swap(tmp);
+        return *this;
+    }
+    List &operator=(List &&rhs) noexcept {
+        if (std::addressof(rhs) == this) return *this;
+        List tmp(std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+public:
+    template <typename... TArgs>
+    iterator emplace(const_iterator pos, TArgs &&... args) {
+        Node *node = create_node(std::forward<TArgs>(args)...);
+        link_before(pos._node, node);
+        ++_size;
+        return iterator(node);
+    }
+    iterator insert(const_iterator pos, const_reference val) { return emplace(pos, val); }
+    iterator insert(const_iterator pos, value_type &&val) { return emplace(pos, std::move(val)); }
+    iterator erase(const_iterator pos) {
+        NodeBase *next = pos._node->next;
+        unlink(pos._node);
+        destroy_node(static_cast<Node *>(pos._node));
+        --_size;
+        return iterator(next);
+    }
+    template <typename... TArgs>
+    reference emplace_back(TArgs &&... args) {
+        return *emplace(end(), std::forward<TArgs>(args)...);
+    }
+    template <typename... TArgs>
+    reference emplace_front(TArgs &&... args) {
+        return *emplace(begin(), std::forward<TArgs>(args)...);
+    }
+    void push_back(const_reference val) { emplace_back(val); }
+    void push_back(value_type &&val) { emplace_back(std::move(val)); }
+    void push_front(const_reference val) { emplace_front(val); }
+    void push_front(value_type &&val) { emplace_front(std::move(val)); }
+    void pop_back() { erase(std::prev(end())); }
+    void pop_front() { erase(begin()); }
+    void clear() noexcept {
+        NodeBase *node = _sentinel.next;
+        while (node != &_sentinel) {
+            NodeBase *next = node->next;
+            destroy_node(static_cast<Node *>(node));
+            node = next;
+        }
+        reset();
+    }
+    // 把 other 的全部节点移到 pos 之前, 不分配也不复制元素
+    void splice(const_iterator pos, List &other) noexcept {
+        if (std::addressof(other) == this || other.empty()) return;
+        NodeBase *first = other._sentinel.next, *last = other._sentinel.prev;
+        NodeBase *next = pos._node, *prev = next->prev;
+        prev->next = first;
+        first->prev = prev;
+        last->next = next;
+        next->prev = last;
+        _size += other._size;
+        other.reset();
+    }
+    void swap(List &rhs) noexcept {
+        using std::swap;
+        swap(_sentinel, rhs._sentinel);
+        swap(_size, rhs._size);
+        swap(_alloc, rhs._alloc);
+        relink_sentinel();
+        rhs.relink_sentinel();
+    }
+
+    // 把有序的 other 归并进有序的本链表, 只修改链接; 相等时本链表的元素在前
+    template <typename TComparer>
+    void merge(List &other, TComparer comp) {
+        if (std::addressof(other) == this) return;
+        NodeBase *pos = _sentinel.next, *node = other._sentinel.next;
+        while (node != &other._sentinel) {
+            if (pos == &_sentinel) {
+                splice(end(), other);
+                return;
+            }
+            if (comp(value_of(node), value_of(pos))) {
+                NodeBase *next = node->next;
+                unlink(node);
+                link_before(pos, node);
+                ++_size;
+                --other._size;
+                node = next;
+            } else {
+                pos = pos->next;
+            }
+        }
+    }
+    void merge(List &other) { merge(other, std::less<>()); }
+
+    // 稳定的自底向上自然归并排序, 只重新链接节点, 不分配内存
+    // 依次取出输入中已有的 run (非递减段, 严格递减段反转后使用), 像二进制计数器一样合并:
+    // bins[i] 为空或是由大约 2^i 个 run 归并成的有序单链表, 因此额外空间只有 64 个指针
+    // 已经有序的输入只有一个 run, 只需 n - 1 次比较
+    template <typename TComparer>
+    void sort(TComparer comp) {
+        if (_size < 2) return;
+        NodeBase *bins[64] = {};
+        size_t used = 0;
+
+        // 先变成以 nullptr 结尾的单链表
+        _sentinel.prev->next = nullptr;
+        NodeBase *rest = _sentinel.next;
+        while (rest != nullptr) {
+            NodeBase *run = take_run(rest, comp);
+            size_t i = 0;
+            for (; i != used && bins[i] != nullptr; ++i) {
+                // bins[i] 中的元素在输入中位于 run 之前, 放在左边才能保持稳定
+                run = merge_runs(bins[i], run, comp);
+                bins[i] = nullptr;
+            }
+            bins[i] = run;
+            if (i == used) ++used;
+        }
+        NodeBase *result = nullptr;
+        for (size_t i = 0; i != used; ++i) {
+            if (bins[i] != nullptr) result = merge_runs(bins[i], result, comp);
+        }
+
+        // 恢复 prev 指针和循环结构
+        NodeBase *prev = &_sentinel;
+        for (NodeBase *node = result; node != nullptr; node = node->next) {
+            prev->next = node;
+            node->prev = prev;
+            prev = node;
+        }
+        prev->next = &_sentinel;
+        _sentinel.prev = prev;
+    }
+    void sort() { sort(std::less<>()); }
+
+public:
+    reference front() noexcept { return value_of(_sentinel.next); }
+    const_reference front() const noexcept { return value_of(_sentinel.next); }
+    reference back() noexcept { return value_of(_sentinel.prev); }
+    const_reference back() const noexcept { return value_of(_sentinel.prev); }
+    iterator begin() noexcept { return iterator(_sentinel.next); }
+    iterator end() noexcept { return iterator(&_sentinel); }
+    const_iterator begin() const noexcept { return const_iterator(_sentinel.next); }
+    const_iterator end() const noexcept { return const_iterator(sentinel()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    size_type size() const noexcept { return _size; }
+    bool empty() const noexcept { return _size == 0; }
+    allocator_type get_allocator() const { return allocator_type(_alloc); }
+
+private:
+    static T &value_of(NodeBase *node) noexcept { return static_cast<Node *>(node)->data; }
+    NodeBase *sentinel() const noexcept { return const_cast<NodeBase *>(&_sentinel); }
+    void reset() noexcept {
+        _sentinel.prev = _sentinel.next = &_sentinel;
+        _size = 0;
+    }
+    // 复制或交换哨兵后, 让首尾节点重新指向本链表的哨兵
+    void relink_sentinel() noexcept {
+        if (_size == 0)
+            reset();
+        else
+            _sentinel.next->prev = _sentinel.prev->next = &_sentinel;
+    }
+    // 接管 rhs 的全部节点, 本链表必须为空
+    void take(List &rhs) noexcept {
+        _sentinel = rhs._sentinel;
+        _size = rhs._size;
+        relink_sentinel();
+        rhs.reset();
+    }
+    static void link_before(NodeBase *pos, NodeBase *node) noexcept {
+        node->prev = pos->prev;
+        node->next = pos;
+        pos->prev->next = node;
+        pos->prev = node;
+    }
+    static void unlink(NodeBase *node) noexcept {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+    }
+    template <typename... TArgs>
+    Node *create_node(TArgs &&... args) {
+        Node *node = node_traits::allocate(_alloc, 1);
+        try {
+            node_traits::construct(_alloc, std::addressof(node->data),
+                                   std::forward<TArgs>(args)...);
+        } catch (...) {
+            node_traits::deallocate(_alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+    void destroy_node(Node *node) noexcept {
+        node_traits::destroy(_alloc, std::addressof(node->data));
+        node_traits::deallocate(_alloc, node, 1);
+    }
+
+    // 从单链表 list 的开头取下一个 run, list 指向剩余部分
+    template <typename TComparer>
+    static NodeBase *take_run(NodeBase *&list, TComparer &comp) {
+        NodeBase *head = list, *tail = head;
+        if (tail->next != nullptr && comp(value_of(tail->next), value_of(tail))) {
+            // 严格递减: 边取边插到前面, 得到非递减的 run
+            do {
+                NodeBase *node = tail->next;
+                tail->next = node->next;
+                node->next = head;
+                head = node;
+            } while (tail->next != nullptr && comp(value_of(tail->next), value_of(head)));
+        } else if (tail->next != nullptr) {
+            tail = tail->next;  // 前两个元素已经比较过
+            while (tail->next != nullptr && !comp(value_of(tail->next), value_of(tail))) {
+                tail = tail->next;
+            }
+        }
+        list = tail->next;
+        tail->next = nullptr;
+        return head;
+    }
+    // 归并两个有序单链表, 相等时取 left 的元素
+    template <typename TComparer>
+    static NodeBase *merge_runs(NodeBase *left, NodeBase *right, TComparer &comp) {
+        NodeBase head;
+        NodeBase *tail = &head;
+        while (left != nullptr && right != nullptr) {
+            if (comp(value_of(right), value_of(left))) {
+                tail->next = right;
+                right = right->next;
+            } else {
+                tail->next = left;
+                left = left->next;
+            }
+            tail = tail->next;
+        }
+        tail->next = left != nullptr ? left : right;
+        return head.next;
+    }
 
 private:
-    Node *head;
-    Node *rear;
+    NodeBase _sentinel;
+    size_type _size = 0;
+    node_allocator _alloc;
 };
 
+template <typename T, typename A>
+inline bool operator==(const List<T, A> &lhs, const List<T, A> &rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+template <typename T, typename A>
+inline bool operator!=(const List<T, A> &lhs, const List<T, A> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename A>
+inline void swap(alg::List<T, A> &x, alg::List<T, A> &y) {
+    x.swap(y);
+}
+
 }  // namespace alg
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace alg {
+
+// 把整个文件映射到内存. 映射是私有的 (写时复制): 可以修改映射的内容,
+// 被修改的页面在第一次写入时复制一份, 只对本进程可见, 不会写回文件
+class MappedFile {
+public:
+    MappedFile() = default;
+    // 打开失败时抛出 std::runtime_error
+    static MappedFile open_private(const std::string &path);
+    MappedFile(const MappedFile &) = delete;
+    MappedFile(MappedFile &&rhs) noexcept { swap(rhs); }
+    ~MappedFile() { close(); }
+
+public:
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile &operator=(MappedFile &&rhs) noexcept {
+        MappedFile tmp(static_cast<MappedFile &&>(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+public:
+    void close() noexcept;
+    void swap(MappedFile &rhs) noexcept;
+    char *data() noexcept { return _data; }
+    const char *data() const noexcept { return _data; }
+    size_t size() const noexcept { return _size; }
+    bool is_open() const noexcept { return _data != nullptr; }
+
+private:
+    char *_data = nullptr;
+    size_t _size = 0;
+#if defined(_WIN32)
+    void *_file = nullptr;     // HANDLE
+    void *_mapping = nullptr;  // HANDLE
+#endif
+};
+
+}  // namespace alg
@@ -101,7 +101,7 @@ std::pair<InputIt, ForwardIt> uninit_move_n_using_alloc(TAlloc &alloc,
     try {
         for (; n > 0; ++first, (void)++current, --n) {
             std::allocator_traits<TAlloc>::construct(
-                alloc, std::addressof(*current), *first);
+                alloc, std::addressof(*current), std::move(*first));
         }
     } catch (...) {
         for (; dfirst != current; ++dfirst) {
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace alg {
+
+// n × n 的渗透模型: 格点开始全部关闭, 打开的相邻格点 (上下左右) 连通;
+// 顶行与底行之间存在连通的打开格点时称系统渗透
+// 另设虚拟的顶部节点和底部节点, 分别与顶行和底行的打开格点相连, 判断渗透只需一次连通查询
+// TUnionFind 可以是任何提供 TUnionFind(size_t), connect 和 is_connected 的并查集
+template <typename TUnionFind>
+class Percolation {
+public:
+    explicit Percolation(size_t n) : _n(n), _open(n * n), _uf(n * n + 2) {
+        if (n == 0) throw std::invalid_argument("Grid size must be positive.");
+    }
+
+public:
+    // 打开 (row, col) 格点并与相邻的打开格点合并; 已经打开时什么也不做
+    void open(size_t row, size_t col) {
+        check(row, col);
+        size_t site = row * _n + col;
+        if (_open[site]) return;
+        _open[site] = true;
+        ++_open_count;
+        if (row == 0) _uf.connect(site, top());
+        if (row == _n - 1) _uf.connect(site, bottom());
+        if (row > 0 && _open[site - _n]) _uf.connect(site, site - _n);
+        if (row + 1 < _n && _open[site + _n]) _uf.connect(site, site + _n);
+        if (col > 0 && _open[site - 1]) _uf.connect(site, site - 1);
+        if (col + 1 < _n && _open[site + 1]) _uf.connect(site, site + 1);
+    }
+    bool is_open(size_t row, size_t col) const {
+        check(row, col);
+        return _open[row * _n + col];
+    }
+    // 格点与顶行连通 (对底行格点而言, 可能经由虚拟底部节点回流, 结果偏大)
+    bool is_full(size_t row, size_t col) {
+        check(row, col);
+        return _open[row * _n + col] && _uf.is_connected(row * _n + col, top());
+    }
+    bool percolates() { return _uf.is_connected(top(), bottom()); }
+    size_t open_count() const noexcept { return _open_count; }
+    size_t size() const noexcept { return _n; }
+
+private:
+    size_t top() const noexcept { return _n * _n; }
+    size_t bottom() const noexcept { return _n * _n + 1; }
+    void check(size_t row, size_t col) const {
+        if (row >= _n || col >= _n) throw std::out_of_range("Index out of range.");
+    }
+
+private:
+    size_t _n;
+    size_t _open_count = 0;
+    std::vector<bool> _open;
+    TUnionFind _uf;
+};
+
+// 蒙特卡洛估计渗透阈值的结果
+struct PercolationStats {
+    size_t n = 0;
+    size_t trials = 0;
+    double mean = 0;       // 渗透时打开格点比例的平均值, 即阈值的估计
+    double stddev = 0;     // 样本标准差
+    double ci_low = 0;     // 95% 置信区间
+    double ci_high = 0;
+    size_t opened = 0;     // 所有试验一共打开的格点数
+    double seconds = 0;    // 墙上时间
+    double open_ns = 0;    // 平均每次 open (含渗透判断) 的耗时, 纳秒, 不含每次试验的初始化
+};
+
+// 独立进行 trials 次试验: 按随机顺序打开格点, 直到系统渗透
+// 试验分给 threads 个线程 (0 表示硬件线程数), 每个线程有自己的随机数引擎,
+// 第 i 次试验的引擎以 seed 和 i 为种子, 因此结果与线程数无关
+template <typename TUnionFind>
+PercolationStats estimate_percolation(size_t n, size_t trials, size_t threads = 0,
+                                      uint64_t seed = 2019) {
+    if (n == 0 || trials < 2) throw std::invalid_argument("Need a grid and at least 2 trials.");
+    if (threads == 0) threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threads = std::min(threads, trials);
+
+    using clock = std::chrono::steady_clock;
+    std::vector<double> fractions(trials);
+    std::vector<size_t> opened(threads);
+    std::vector<double> busy(threads);
+    auto worker = [&](size_t t) {
+        std::mt19937_64 rand;
+        std::vector<uint32_t> sites(n * n);
+        for (size_t i = t; i < trials; i += threads) {
+            rand.seed(seed + 0x9e3779b97f4a7c15ull * (i + 1));
+            Percolation<TUnionFind> perc(n);
+            for (size_t s = 0; s != sites.size(); ++s) sites[s] = static_cast<uint32_t>(s);
+            // 只计 open 和渗透判断的时间, 创建并查集和重置 sites 不算在内
+            auto start = clock::now();
+            // 边打开边洗牌: 第 k 步从剩下的格点中均匀地选一个
+            for (size_t k = 0; !perc.percolates(); ++k) {
+                size_t j = k + rand() % (sites.size() - k);
+                std::swap(sites[k], sites[j]);
+                perc.open(sites[k] / n, sites[k] % n);
+            }
+            busy[t] += std::chrono::duration<double>(clock::now() - start).count();
+            fractions[i] = static_cast<double>(perc.open_count()) / (n * n);
+            opened[t] += perc.open_count();
+        }
+    };
+
+    auto start = clock::now();
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto &th : pool) th.join();
+
+    PercolationStats stats;
+    stats.n = n;
+    stats.trials = trials;
+    stats.seconds = std::chrono::duration<double>(clock::now() - start).count();
+    double sum = 0, busy_total = 0;
+    for (double f : fractions) sum += f;
+    stats.mean = sum / trials;
+    double var = 0;
+    for (double f : fractions) var += (f - stats.mean) * (f - stats.mean);
+    stats.stddev = std::sqrt(var / (trials - 1));
+    double half = 1.96 * stats.stddev / std::sqrt(static_cast<double>(trials));
+    stats.ci_low = stats.mean - half;
+    stats.ci_high = stats.mean + half;
+    for (size_t t = 0; t != threads; ++t) {
+        stats.opened += opened[t];
+        busy_total += busy[t];
+    }
+    stats.open_ns = stats.opened ? busy_total * 1e9 / stats.opened : 0;
+    return stats;
+}
+
+}  // namespace alg
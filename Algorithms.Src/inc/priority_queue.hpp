@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "resizing_array.hpp"
+#include "sort/heap_sort.hpp"
+
+namespace alg {
+
+// 基于 D 叉堆的优先队列适配器, 与 std::priority_queue 一样, 堆顶是按 comp 最大的元素
+// 需要最小堆时使用 std::greater<T>
+template <typename T, typename TContainer = ResizingArray<T>, typename TComparer = std::less<T>,
+          size_t D = 4>
+class PriorityQueue {
+    static_assert(D >= 2, "Arity must be at least 2.");
+
+public:
+    using container_type = TContainer;
+    using value_compare = TComparer;
+    using value_type = typename container_type::value_type;
+    using size_type = typename container_type::size_type;
+    using reference = typename container_type::reference;
+    using const_reference = typename container_type::const_reference;
+
+public:
+    explicit PriorityQueue(TComparer comp = TComparer()) : _comp(comp) {}
+    // 批量建堆, O(n)
+    explicit PriorityQueue(container_type container, TComparer comp = TComparer())
+        : _container(std::move(container)), _comp(comp) {
+        __make_heap<D>(_container.begin(), _container.size(), _comp);
+    }
+    template <typename InputIt>
+    PriorityQueue(InputIt first, InputIt last, TComparer comp = TComparer()) : _comp(comp) {
+        push_range(first, last);
+    }
+    PriorityQueue(std::initializer_list<value_type> values, TComparer comp = TComparer())
+        : PriorityQueue(values.begin(), values.end(), comp) {}
+
+public:
+    void push(const value_type &value) {
+        _container.push_back(value);
+        __heap_sift_up<D>(_container.begin(), _container.size() - 1, _comp);
+    }
+    void push(value_type &&value) {
+        _container.push_back(std::move(value));
+        __heap_sift_up<D>(_container.begin(), _container.size() - 1, _comp);
+    }
+    template <typename... TArgs>
+    void emplace(TArgs &&... args) {
+        _container.emplace_back(std::forward<TArgs>(args)...);
+        __heap_sift_up<D>(_container.begin(), _container.size() - 1, _comp);
+    }
+    // 批量加入: 新元素较多时整体重新建堆 (O(n)), 否则逐个上浮
+    template <typename InputIt>
+    void push_range(InputIt first, InputIt last) {
+        size_type old_size = _container.size();
+        for (; first != last; ++first) _container.push_back(*first);
+        size_type n = _container.size();
+        if (n - old_size > old_size / 4) {
+            __make_heap<D>(_container.begin(), n, _comp);
+        } else {
+            for (size_type i = old_size; i != n; ++i) {
+                __heap_sift_up<D>(_container.begin(), i, _comp);
+            }
+        }
+    }
+    // 移除并返回堆顶
+    value_type pop() {
+        value_type result = std::move(_container.front());
+        if (_container.size() > 1) {
+            _container.front() = std::move(_container.back());
+            _container.pop_back();
+            __heap_sift_down<D>(_container.begin(), _container.size(), 0, _comp);
+        } else {
+            _container.pop_back();
+        }
+        return result;
+    }
+    void clear() { _container.clear(); }
+    void swap(PriorityQueue &rhs) {
+        using std::swap;
+        _container.swap(rhs._container);
+        swap(_comp, rhs._comp);
+    }
+
+public:
+    const_reference top() const noexcept { return _container.front(); }
+    bool empty() const { return _container.empty(); }
+    size_type size() const { return _container.size(); }
+
+private:
+    container_type _container;
+    TComparer _comp;
+};
+
+// 带索引的优先队列: 元素用 [0, n) 中的整数标识, 可以修改任意元素的键
+// 默认是最小堆 (堆顶的键最小), decrease_key 正好对应 Dijkstra 一类算法中的松弛操作
+template <typename TKey, typename TComparer = std::greater<TKey>, size_t D = 4>
+class IndexedPriorityQueue {
+    static_assert(D >= 2, "Arity must be at least 2.");
+
+public:
+    using key_type = TKey;
+    using size_type = size_t;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+public:
+    explicit IndexedPriorityQueue(size_type n, TComparer comp = TComparer())
+        : _heap(n), _pos(n), _keys(n), _comp(comp) {
+        _pos.resize(n, npos);
+        _keys.resize(n);
+    }
+
+public:
+    void push(size_type i, const TKey &key) {
+        check_index(i);
+        if (contains(i)) throw std::invalid_argument("Index is already in the queue.");
+        _keys[i] = key;
+        _pos[i] = _heap.size();
+        _heap.push_back(i);
+        sift_up(_heap.size() - 1);
+    }
+    // 移除堆顶并返回它的索引
+    size_type pop() {
+        size_type top = _heap.front();
+        erase(top);
+        return top;
+    }
+    // 把 i 的键改成优先级不低于原来的 key, 只需要上浮
+    void decrease_key(size_type i, const TKey &key) {
+        check_contains(i);
+        if (_comp(key, _keys[i])) throw std::invalid_argument("Key would lower the priority.");
+        _keys[i] = key;
+        sift_up(_pos[i]);
+    }
+    // 任意修改 i 的键
+    void change_key(size_type i, const TKey &key) {
+        check_contains(i);
+        _keys[i] = key;
+        sift_up(_pos[i]);
+        sift_down(_pos[i]);
+    }
+    void erase(size_type i) {
+        check_contains(i);
+        size_type p = _pos[i];
+        size_type last = _heap.back();
+        _heap[p] = last;
+        _pos[last] = p;
+        _heap.pop_back();
+        _pos[i] = npos;
+        if (p != _heap.size()) {
+            sift_up(p);
+            sift_down(_pos[last]);
+        }
+    }
+
+public:
+    size_type top() const noexcept { return _heap.front(); }
+    const TKey &top_key() const noexcept { return _keys[_heap.front()]; }
+    const TKey &key_of(size_type i) const {
+        check_contains(i);
+        return _keys[i];
+    }
+    bool contains(size_type i) const { return i < _pos.size() && _pos[i] != npos; }
+    bool empty() const noexcept { return _heap.empty(); }
+    size_type size() const noexcept { return _heap.size(); }
+
+private:
+    bool less(size_type a, size_type b) const { return _comp(_keys[_heap[a]], _keys[_heap[b]]); }
+    void place(size_type p, size_type i) {
+        _heap[p] = i;
+        _pos[i] = p;
+    }
+    void sift_up(size_type p) {
+        size_type i = _heap[p];
+        while (p > 0) {
+            size_type parent = (p - 1) / D;
+            if (!_comp(_keys[_heap[parent]], _keys[i])) break;
+            place(p, _heap[parent]);
+            p = parent;
+        }
+        place(p, i);
+    }
+    void sift_down(size_type p) {
+        size_type i = _heap[p], n = _heap.size();
+        while (true) {
+            size_type child = D * p + 1;
+            if (child >= n) break;
+            size_type last = child + D < n ? child + D : n, best = child;
+            for (size_type c = child + 1; c < last; ++c) {
+                if (less(best, c)) best = c;
+            }
+            if (!_comp(_keys[i], _keys[_heap[best]])) break;
+            place(p, _heap[best]);
+            p = best;
+        }
+        place(p, i);
+    }
+    void check_index(size_type i) const {
+        if (i >= _pos.size()) throw std::out_of_range("Index out of range.");
+    }
+    void check_contains(size_type i) const {
+        check_index(i);
+        if (_pos[i] == npos) throw std::invalid_argument("Index is not in the queue.");
+    }
+
+private:
+    ResizingArray<size_type> _heap;  // 堆中的索引
+    ResizingArray<size_type> _pos;   // 索引在堆中的位置, 不在堆中时为 npos
+    ResizingArray<TKey> _keys;
+    TComparer _comp;
+};
+
+}  // namespace alg
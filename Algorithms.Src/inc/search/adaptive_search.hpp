@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "search/binary_search.hpp"
+#include "search/exponential_search.hpp"
+#include "search/interpolation_search.hpp"
+
+namespace alg {
+
+enum class SearchStrategy { Binary, Interpolation };
+
+// 区间太短时插值省不了几次比较
+constexpr size_t __INTERPOLATION_MIN_SIZE = 64;
+constexpr size_t __INTERPOLATION_SAMPLES = 16;
+// 采样点偏离两端连线的最大距离 (相对于值域) 不超过它时认为分布足够均匀
+constexpr double __INTERPOLATION_MAX_SKEW = 0.1;
+
+// 等距取 17 个样本, 与首尾连线比较, 判断升序区间的键是否大致均匀分布
+// 只有算术类型并且按数值升序 (std::less) 排列时才可能选插值查找
+template <typename RandomIt, typename TComparer = std::less<>>
+SearchStrategy choose_search_strategy(RandomIt first, RandomIt last, TComparer = TComparer()) {
+    using V = typename std::iterator_traits<RandomIt>::value_type;
+    if constexpr (std::is_arithmetic_v<V> && (std::is_same_v<TComparer, std::less<>> ||
+                                              std::is_same_v<TComparer, std::less<V>>)) {
+        auto n = last - first;
+        if (n < static_cast<decltype(n)>(__INTERPOLATION_MIN_SIZE)) return SearchStrategy::Binary;
+        double lo = static_cast<double>(first[0]), hi = static_cast<double>(first[n - 1]);
+        if (!(hi > lo) || !std::isfinite(hi - lo)) return SearchStrategy::Binary;
+        for (size_t i = 1; i < __INTERPOLATION_SAMPLES; ++i) {
+            auto pos = (n - 1) * i / __INTERPOLATION_SAMPLES;
+            double expected = lo + (hi - lo) * pos / (n - 1);
+            double skew = std::abs(static_cast<double>(first[pos]) - expected) / (hi - lo);
+            if (!(skew <= __INTERPOLATION_MAX_SKEW)) return SearchStrategy::Binary;
+        }
+        return SearchStrategy::Interpolation;
+    } else {
+        return SearchStrategy::Binary;
+    }
+}
+
+// 对同一个有序区间反复查找: 构造时采样一次选定策略, 之后每次查找直接分派
+// equal_range 先找下界, 再从下界向后 galloping 找上界, 重复键不多时只需几次比较
+template <typename RandomIt, typename TComparer = std::less<>>
+class SortedSearcher {
+public:
+    SortedSearcher(RandomIt first, RandomIt last, TComparer comp = TComparer())
+        : _first(first),
+          _last(last),
+          _comp(comp),
+          _strategy(choose_search_strategy(first, last, comp)) {}
+
+public:
+    SearchStrategy strategy() const noexcept { return _strategy; }
+
+    template <typename T>
+    RandomIt lower_bound(const T &key) const {
+        if constexpr (interpolatable<T>()) {
+            if (_strategy == SearchStrategy::Interpolation)
+                return interpolation_lower_bound(_first, _last, key, _comp);
+        }
+        return alg::lower_bound(_first, _last, key, _comp);
+    }
+    template <typename T>
+    RandomIt upper_bound(const T &key) const {
+        if constexpr (interpolatable<T>()) {
+            if (_strategy == SearchStrategy::Interpolation)
+                return interpolation_upper_bound(_first, _last, key, _comp);
+        }
+        return alg::upper_bound(_first, _last, key, _comp);
+    }
+    template <typename T>
+    std::pair<RandomIt, RandomIt> equal_range(const T &key) const {
+        RandomIt lo = lower_bound(key);
+        return {lo, exponential_upper_bound(lo, _last, key, _comp)};
+    }
+    // 如果找到, 返回 [first, last) 之间的迭代器, 否则返回 last
+    template <typename T>
+    RandomIt find(const T &key) const {
+        RandomIt pos = lower_bound(key);
+        return pos != _last && !_comp(key, *pos) ? pos : _last;
+    }
+
+private:
+    template <typename T>
+    static constexpr bool interpolatable() {
+        return std::is_arithmetic_v<typename std::iterator_traits<RandomIt>::value_type> &&
+               std::is_arithmetic_v<T>;
+    }
+
+private:
+    RandomIt _first, _last;
+    TComparer _comp;
+    SearchStrategy _strategy;
+};
+
+}  // namespace alg
@@ -1,24 +1,88 @@
 #pragma once
 
-#include <cassert>
-#include <iostream>
+#include <functional>
+#include <utility>
 
 namespace alg {
+
+// 返回第一个不小于 key 的位置, 没有时返回 last
+template <typename RandomIt, typename T, typename TComparer>
+RandomIt lower_bound(RandomIt first, RandomIt last, const T &key, TComparer comp) {
+    auto count = last - first;
+    while (count > 0) {
+        auto half = count / 2;
+        RandomIt mid = first + half;
+        if (comp(*mid, key)) {
+            first = mid + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+template <typename RandomIt, typename T>
+RandomIt lower_bound(RandomIt first, RandomIt last, const T &key) {
+    return alg::lower_bound(first, last, key, std::less<>());
+}
+
+// 返回第一个大于 key 的位置, 没有时返回 last
+template <typename RandomIt, typename T, typename TComparer>
+RandomIt upper_bound(RandomIt first, RandomIt last, const T &key, TComparer comp) {
+    auto count = last - first;
+    while (count > 0) {
+        auto half = count / 2;
+        RandomIt mid = first + half;
+        if (!comp(key, *mid)) {
+            first = mid + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+template <typename RandomIt, typename T>
+RandomIt upper_bound(RandomIt first, RandomIt last, const T &key) {
+    return alg::upper_bound(first, last, key, std::less<>());
+}
+
+// 与 key 等价的元素组成的区间 [lower_bound, upper_bound)
+// 两个边界在第一次命中之前的查找路径相同, 命中后分别在左右两半继续
+template <typename RandomIt, typename T, typename TComparer>
+std::pair<RandomIt, RandomIt> equal_range(RandomIt first, RandomIt last, const T &key,
+                                          TComparer comp) {
+    auto count = last - first;
+    while (count > 0) {
+        auto half = count / 2;
+        RandomIt mid = first + half;
+        if (comp(*mid, key)) {
+            first = mid + 1;
+            count -= half + 1;
+        } else if (comp(key, *mid)) {
+            count = half;
+        } else {
+            return {alg::lower_bound(first, mid, key, comp),
+                    alg::upper_bound(mid + 1, first + count, key, comp)};
+        }
+    }
+    return {first, first};
+}
+template <typename RandomIt, typename T>
+std::pair<RandomIt, RandomIt> equal_range(RandomIt first, RandomIt last, const T &key) {
+    return alg::equal_range(first, last, key, std::less<>());
+}
+
 // 如果找到, 返回 [first, last) 之间的迭代器
 // 如果未找到, 返回last
+template <typename RandomIt, typename T, typename TComparer>
+RandomIt binary_search(RandomIt first, RandomIt last, const T &key, TComparer comp) {
+    RandomIt pos = alg::lower_bound(first, last, key, comp);
+    return pos != last && !comp(key, *pos) ? pos : last;
+}
 template <typename RandomIt, typename T>
 RandomIt binary_search(RandomIt first, RandomIt last, const T &key) {
-    RandomIt lo = first, hi = last - 1;
-    while (lo <= hi) {
-        RandomIt mid = lo + (hi - lo) / 2;
-        if (key < *mid)
-            hi = mid - 1;
-        else if (key > *mid)
-            lo = mid + 1;
-        else
-            return mid;
-    }
-    return last;
+    return alg::binary_search(first, last, key, std::less<>());
 }
 
 }  // namespace alg
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <functional>
+
+#include "search/binary_search.hpp"
+
+namespace alg {
+
+// 指数 (galloping) 查找: 从 first 开始以 1, 2, 4, ... 的步长向后试探, 找到包含结果的区间后二分
+// 比较次数为 O(log d), d 为结果到 first 的距离, 与区间长度无关,
+// 因此适合结果靠近起点的查找, 或者 last 很远, 只是作为上界的情形
+template <typename RandomIt, typename T, typename TComparer>
+RandomIt exponential_lower_bound(RandomIt first, RandomIt last, const T &key, TComparer comp) {
+    auto count = last - first;
+    decltype(count) lo = 0, bound = 1;
+    // 循环结束时 [first, first + lo) 中的元素都小于 key
+    while (bound <= count && comp(first[bound - 1], key)) {
+        lo = bound;
+        bound *= 2;
+    }
+    return alg::lower_bound(first + lo, first + (bound <= count ? bound - 1 : count), key, comp);
+}
+template <typename RandomIt, typename T>
+RandomIt exponential_lower_bound(RandomIt first, RandomIt last, const T &key) {
+    return alg::exponential_lower_bound(first, last, key, std::less<>());
+}
+
+template <typename RandomIt, typename T, typename TComparer>
+RandomIt exponential_upper_bound(RandomIt first, RandomIt last, const T &key, TComparer comp) {
+    auto count = last - first;
+    decltype(count) lo = 0, bound = 1;
+    while (bound <= count && !comp(key, first[bound - 1])) {
+        lo = bound;
+        bound *= 2;
+    }
+    return alg::upper_bound(first + lo, first + (bound <= count ? bound - 1 : count), key, comp);
+}
+template <typename RandomIt, typename T>
+RandomIt exponential_upper_bound(RandomIt first, RandomIt last, const T &key) {
+    return alg::exponential_upper_bound(first, last, key, std::less<>());
+}
+
+// 从 hint 出发向两侧 galloping, 返回与 lower_bound 相同的位置
+// 连续查找递增的键时把上一次的结果作为 hint, 总代价与键之间的距离成对数关系
+template <typename RandomIt, typename T, typename TComparer>
+RandomIt hinted_lower_bound(RandomIt first, RandomIt last, RandomIt hint, const T &key,
+                            TComparer comp) {
+    if (hint == last || !comp(*hint, key)) {
+        // 结果在 [first, hint] 中, 从 hint 向前试探
+        auto count = hint - first;
+        decltype(count) hi = 0, bound = 1;
+        while (bound <= count && !comp(hint[-bound], key)) {
+            hi = bound;
+            bound *= 2;
+        }
+        RandomIt lo = bound <= count ? hint - bound + 1 : first;
+        return alg::lower_bound(lo, hint - hi, key, comp);
+    }
+    return alg::exponential_lower_bound(hint + 1, last, key, comp);
+}
+template <typename RandomIt, typename T>
+RandomIt hinted_lower_bound(RandomIt first, RandomIt last, RandomIt hint, const T &key) {
+    return alg::hinted_lower_bound(first, last, hint, key, std::less<>());
+}
+
+}  // namespace alg
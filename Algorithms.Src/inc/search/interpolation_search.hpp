@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+#include "search/binary_search.hpp"
+
+namespace alg {
+
+// 插值查找: 假设键大致均匀分布, 按键在两端之间的比例估计位置, 期望 O(log log n) 次比较
+// 连续两次插值都没有使区间减半时补一次二分, 因此最坏也是 O(log n)
+// 只适用于算术类型的升序区间, comp 必须与数值的 < 一致 (可以是计数用的包装)
+template <typename RandomIt, typename T, typename TBefore, typename TBisect>
+RandomIt __interpolation_bound(RandomIt first, RandomIt last, const T &key, TBefore before,
+                               TBisect bisect) {
+    using V = typename std::iterator_traits<RandomIt>::value_type;
+    static_assert(std::is_arithmetic_v<V> && std::is_arithmetic_v<T>,
+                  "Interpolation search needs arithmetic keys.");
+    auto n = last - first;
+    if (n == 0 || !before(first[0])) return first;
+    if (before(first[n - 1])) return last;
+
+    // 不变式: first[lo - 1] 在结果之前, first[hi] 不在, 结果在 [lo, hi] 中
+    decltype(n) lo = 1, hi = n - 1;
+    auto probe = [&](decltype(n) pos) {
+        if (before(first[pos]))
+            lo = pos + 1;
+        else
+            hi = pos;
+    };
+    int slow = 0;
+    while (hi - lo > 8) {
+        auto width = hi - lo;
+        double a = static_cast<double>(first[lo - 1]), b = static_cast<double>(first[hi]);
+        double est = (lo - 1) + (static_cast<double>(key) - a) / (b - a) * (hi - lo + 1);
+        // 比较失败 (例如 NaN) 时也落在区间内
+        if (!(est >= lo)) est = static_cast<double>(lo);
+        if (!(est <= hi - 1)) est = static_cast<double>(hi - 1);
+        probe(static_cast<decltype(n)>(est));
+        // 估计位置往往紧挨着结果, 只有远离结果的一侧大幅缩小, 所以偶尔一次没有减半不要紧
+        if (hi - lo <= width / 2)
+            slow = 0;
+        else if (++slow == 2) {
+            probe(lo + (hi - lo) / 2);
+            slow = 0;
+        }
+    }
+    return bisect(first + lo, first + hi);
+}
+
+template <typename RandomIt, typename T, typename TComparer>
+RandomIt interpolation_lower_bound(RandomIt first, RandomIt last, const T &key, TComparer comp) {
+    return __interpolation_bound(
+        first, last, key, [&](const auto &v) { return comp(v, key); },
+        [&](RandomIt lo, RandomIt hi) { return alg::lower_bound(lo, hi, key, comp); });
+}
+template <typename RandomIt, typename T>
+RandomIt interpolation_lower_bound(RandomIt first, RandomIt last, const T &key) {
+    return alg::interpolation_lower_bound(first, last, key, std::less<>());
+}
+
+template <typename RandomIt, typename T, typename TComparer>
+RandomIt interpolation_upper_bound(RandomIt first, RandomIt last, const T &key, TComparer comp) {
+    return __interpolation_bound(
+        first, last, key, [&](const auto &v) { return !comp(key, v); },
+        [&](RandomIt lo, RandomIt hi) { return alg::upper_bound(lo, hi, key, comp); });
+}
+template <typename RandomIt, typename T>
+RandomIt interpolation_upper_bound(RandomIt first, RandomIt last, const T &key) {
+    return alg::interpolation_upper_bound(first, last, key, std::less<>());
+}
+
+}  // namespace alg
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "utility.hpp"
+
+namespace alg {
+
+// D 叉堆: 下标 i 的子节点为 D * i + 1 ~ D * i + D, 父节点为 (i - 1) / D
+// 堆顶是按 comp 最大的元素; D 取 4 或 8 时一次比较的子节点位于同一缓存行, 树也更矮
+// 上浮和下沉都是先取出元素留下空位, 沿路径移动其他元素, 最后再放回
+
+template <size_t D, typename RandomIt, typename TComparer>
+void __heap_sift_up(RandomIt first, size_t i, TComparer comp) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    value_type v = iter_move(first + i);
+    while (i > 0) {
+        size_t parent = (i - 1) / D;
+        if (!lt(first[parent], v, comp)) break;
+        first[i] = iter_move(first + parent);
+        i = parent;
+    }
+    first[i] = std::move(v);
+}
+template <size_t D, typename RandomIt, typename TComparer>
+void __heap_sift_down(RandomIt first, size_t n, size_t i, TComparer comp) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    value_type v = iter_move(first + i);
+    while (true) {
+        size_t child = D * i + 1;
+        if (child >= n) break;
+        size_t last = std::min(child + D, n), best = child;
+        for (size_t c = child + 1; c < last; ++c) {
+            if (lt(first[best], first[c], comp)) best = c;
+        }
+        if (!lt(v, first[best], comp)) break;
+        first[i] = iter_move(first + best);
+        i = best;
+    }
+    first[i] = std::move(v);
+}
+// 自底向上建堆, O(n)
+template <size_t D, typename RandomIt, typename TComparer>
+void __make_heap(RandomIt first, size_t n, TComparer comp) {
+    if (n < 2) return;
+    for (size_t i = (n - 2) / D + 1; i-- > 0;) __heap_sift_down<D>(first, n, i, comp);
+}
+
+template <typename RandomIt, typename TComparer>
+void heap_sort(RandomIt first, RandomIt last, TComparer comp) {
+    constexpr size_t D = 4;
+    size_t n = last - first;
+    __make_heap<D>(first, n, comp);
+    while (n > 1) {
+        --n;
+        swap_elements(first[0], first[n]);
+        __heap_sift_down<D>(first, n, 0, comp);
+    }
+}
+template <typename RandomIt>
+inline void heap_sort(RandomIt first, RandomIt last) {
+    heap_sort(first, last, compare_asc<typename std::iterator_traits<RandomIt>::value_type>);
+}
+
+}  // namespace alg
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "sort/quick_sort.hpp"
+#include "sort/tim_sort.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+namespace alg {
+
+// 间接排序: 元素很大或比较代价很高时, 只对下标或 (键, 下标) 排序, 最后每个元素只移动一次
+
+// 返回使 [first, last) 有序的下标排列 perm, 即 first[perm[0]], first[perm[1]], ... 有序
+// 用 tim_sort 对下标排序, 因此是稳定的, 并且比较次数较少
+template <typename RandomIt, typename TComparer>
+Vector<size_t> argsort(RandomIt first, RandomIt last, TComparer comp) {
+    size_t n = last - first;
+    Vector<size_t> perm(n);
+    for (size_t i = 0; i != n; ++i) perm.push_back(i);
+    tim_sort(perm.begin(), perm.end(),
+             [first, comp](size_t lhs, size_t rhs) { return comp(first[lhs], first[rhs]); });
+    return perm;
+}
+template <typename RandomIt>
+inline Vector<size_t> argsort(RandomIt first, RandomIt last) {
+    return argsort(first, last,
+                   compare_asc<typename std::iterator_traits<RandomIt>::value_type>);
+}
+
+// 就地重排 [first, last), 使新的 first[i] 为原来的 first[perm[i]]
+// 沿着排列的环移动元素, 每个元素只移动一次, 额外空间只有 n 个标记
+template <typename RandomIt, typename PermIt>
+void apply_permutation(RandomIt first, RandomIt last, PermIt perm) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    size_t n = last - first;
+    Vector<bool> done(n);
+    done.resize(n, false);
+    for (size_t start = 0; start != n; ++start) {
+        if (done[start]) continue;
+        value_type tmp = iter_move(first + start);
+        size_t i = start;
+        while (true) {
+            done[i] = true;
+            size_t from = perm[i];
+            if (from == start) break;
+            first[i] = iter_move(first + from);
+            i = from;
+        }
+        first[i] = std::move(tmp);
+    }
+}
+
+// 按 keyfn 提取的键排序: 每个元素只提取一次键, 对紧凑的 (键, 下标) 数组排序后再重排元素
+// 键相同时按原来的位置排列, 因此是稳定的
+template <typename RandomIt, typename KeyFn, typename TComparer>
+void sort_by_key(RandomIt first, RandomIt last, KeyFn keyfn, TComparer comp) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    using key_type = std::decay_t<std::invoke_result_t<KeyFn &, const value_type &>>;
+    size_t n = last - first;
+    if (n < 2) return;
+
+    Vector<std::pair<key_type, size_t>> keyed(n);
+    for (size_t i = 0; i != n; ++i) keyed.push_back({std::invoke(keyfn, first[i]), i});
+    quick_sort(keyed.begin(), keyed.end(), [comp](const auto &lhs, const auto &rhs) {
+        if (comp(lhs.first, rhs.first)) return true;
+        if (comp(rhs.first, lhs.first)) return false;
+        return lhs.second < rhs.second;
+    });
+
+    Vector<size_t> perm(n);
+    for (const auto &item : keyed) perm.push_back(item.second);
+    apply_permutation(first, last, perm.begin());
+}
+template <typename RandomIt, typename KeyFn>
+inline void sort_by_key(RandomIt first, RandomIt last, KeyFn keyfn) {
+    sort_by_key(first, last, keyfn, std::less<>());
+}
+
+}  // namespace alg
@@ -10,14 +10,16 @@ namespace alg {
 
 template <typename BidIt, typename TComparer>
 void insertion_sort(BidIt first, BidIt last, TComparer comp) {
+    if (first == last) return;
     // 找出最小的元素并放置于数组的左边, 去掉内循环的 j > first 条件
-    std::swap(*first, *std::min_element(first, last, comp));
+    swap_elements(*first, *std::min_element(first, last, comp));
     for (BidIt i = std::next(first); i != last; ++i) {
         // 在内循环中将较大的元素向右移动而不总是交换两个元素
-        auto tmp = std::move(*i);
+        // 用 value_type 而不是 auto: 代理迭代器的 *i 只是引用, 必须取出值
+        typename std::iterator_traits<BidIt>::value_type tmp = iter_move(i);
         BidIt j = i;
         for (; lt(tmp, *std::prev(j), comp); --j) {
-            *j = std::move(*std::prev(j));
+            *j = iter_move(std::prev(j));
         }
         *j = std::move(tmp);
     }
@@ -1,46 +1,65 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <utility>
 
 #include "array.hpp"
+#include "resizing_array.hpp"
 #include "utility.hpp"
 
 namespace alg {
 
-template <typename T, size_t N, typename TComparer>
-void __merge(Array<T, N> &arr, size_t lo, size_t mid, size_t hi,
-             Array<T, N> &aux, TComparer comp) {
+// seq 是随机访问迭代器, aux 是同样长度的辅助数组
+template <typename RandomIt, typename TAux, typename TComparer>
+void __merge(RandomIt seq, size_t lo, size_t mid, size_t hi, TAux &aux, TComparer comp) {
     size_t i = lo, j = mid + 1;
-    std::uninitialized_move(arr.begin(), arr.end(), aux.begin());
+    // 只需要搬动 [lo, hi], 并且是移动而不是复制
+    for (size_t k = lo; k <= hi; ++k) aux[k] = iter_move(seq + k);
     for (size_t k = lo; k <= hi; ++k) {
         if (i > mid)
-            arr[k] = aux[j++];
+            seq[k] = std::move(aux[j++]);
         else if (j > hi)
-            arr[k] = aux[i++];
+            seq[k] = std::move(aux[i++]);
         else if (lt(aux[j], aux[i], comp))
-            arr[k] = aux[j++];
+            seq[k] = std::move(aux[j++]);
         else
-            arr[k] = aux[i++];
+            seq[k] = std::move(aux[i++]);
     }
 };
-template <typename T, size_t N, typename TComparer>
-void __merge_sort(Array<T, N> &arr, size_t lo, size_t hi, Array<T, N> &aux,
-                  TComparer comp) {
+template <typename RandomIt, typename TAux, typename TComparer>
+void __merge_sort(RandomIt seq, size_t lo, size_t hi, TAux &aux, TComparer comp) {
     if (hi <= lo) return;
     size_t mid = lo + (hi - lo) / 2;
-    __merge_sort(arr, lo, mid, aux, comp);      // 将左边排序
-    __merge_sort(arr, mid + 1, hi, aux, comp);  // 将右边排序
-    if (gt(arr[mid], arr[mid + 1], comp)) __merge(arr, lo, mid, hi, aux, comp);
+    __merge_sort(seq, lo, mid, aux, comp);      // 将左边排序
+    __merge_sort(seq, mid + 1, hi, aux, comp);  // 将右边排序
+    if (gt(seq[mid], seq[mid + 1], comp)) __merge(seq, lo, mid, hi, aux, comp);
 }
 template <typename T, size_t N, typename TComparer>
 void merge_sort(Array<T, N> &arr, TComparer comp) {
     if constexpr (N <= 1) return;
     Array<T, N> aux;
-    __merge_sort(arr, 0, N - 1, aux, comp);
+    __merge_sort(arr.begin(), 0, N - 1, aux, comp);
 }
 template <typename T, size_t N>
 void merge_sort(Array<T, N> &arr) {
     merge_sort(arr, compare_asc<T>);
 }
+// 迭代器版本, 也适用于 ZipIterator 这样的代理迭代器
+template <typename RandomIt, typename TComparer>
+void merge_sort(RandomIt first, RandomIt last, TComparer comp) {
+    size_t n = last - first;
+    if (n < 2) return;
+    ResizingArray<typename std::iterator_traits<RandomIt>::value_type> aux(n);
+    // 逐个默认构造而不是 resize, resize 要求元素可以复制
+    for (size_t i = 0; i != n; ++i) aux.emplace_back();
+    __merge_sort(first, 0, n - 1, aux, comp);
+}
+template <typename RandomIt>
+inline void merge_sort(RandomIt first, RandomIt last) {
+    merge_sort(first, last, compare_asc<typename std::iterator_traits<RandomIt>::value_type>);
+}
 
 }  // namespace alg
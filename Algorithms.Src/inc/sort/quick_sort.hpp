@@ -12,16 +12,18 @@ namespace alg {
 template <typename RandomIt, typename TComparer>
 RandomIt __partition(RandomIt lo, RandomIt hi, TComparer comp) {
     RandomIt i = lo, j = hi + 1;
-    auto v = *lo;
+    // 切分元素在循环中不会移动, 直接引用它而不复制 (对代理引用同样成立)
+    auto &&v = *lo;
     while (true) {
         while (lt(*(++i), v, comp))
             if (i == hi) break;
-        while (ge(*(--j), v, comp))
+        // 两边遇到与 v 相等的元素都停下交换, 否则大量重复元素时划分会严重失衡
+        while (lt(v, *(--j), comp))
             if (j == lo) break;
         if (i >= j) break;
-        std::swap(*i, *j);
+        swap_elements(*i, *j);
     }
-    std::swap(*lo, *j);
+    swap_elements(*lo, *j);
     return j;
 }
 
@@ -29,12 +31,14 @@ template <typename RandomIt, typename TComparer>
 void __quick_sort(RandomIt lo, RandomIt hi, TComparer comp) {
     if (lo >= hi) return;
     RandomIt j = __partition(lo, hi, comp);
-    __quick_sort(lo, j, comp);
+    // 切分元素 j 已经就位, 不再参与递归
+    if (j != lo) __quick_sort(lo, std::prev(j), comp);
     __quick_sort(std::next(j), hi, comp);
 }
 
 template <typename RandomIt, typename TComparer>
 void quick_sort(RandomIt beg, RandomIt end, TComparer comp) {
+    if (end - beg < 2) return;
     unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
     std::shuffle(beg, end, std::default_random_engine(seed));
     __quick_sort(beg, std::prev(end), comp);
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include "sort/heap_sort.hpp"
+#include "sort/insertion_sort.hpp"
+#include "sort/quick_sort.hpp"
+#include "utility.hpp"
+
+namespace alg {
+
+// 把 lo, mid, hi 三者的中位数放到 lo, 作为 __partition 的切分元素
+template <typename RandomIt, typename TComparer>
+void __median_of_three_to_front(RandomIt lo, RandomIt hi, TComparer comp) {
+    RandomIt mid = lo + (hi - lo) / 2;
+    if (lt(*mid, *lo, comp)) swap_elements(*mid, *lo);
+    if (lt(*hi, *mid, comp)) swap_elements(*hi, *mid);
+    if (lt(*mid, *lo, comp)) swap_elements(*mid, *lo);
+    // 现在 *lo <= *mid <= *hi
+    swap_elements(*lo, *mid);
+}
+
+template <typename RandomIt, typename TComparer>
+void __select(RandomIt lo, RandomIt hi, RandomIt nth, TComparer comp, bool linear);
+
+// 五个一组取中位数, 再取这些中位数的中位数放到 lo
+// 保证切分后两边都至少有约 3/10 的元素, 选择因此是最坏线性的
+template <typename RandomIt, typename TComparer>
+void __median_of_medians_to_front(RandomIt lo, RandomIt hi, TComparer comp) {
+    size_t n = hi - lo + 1;
+    RandomIt store = lo;
+    for (size_t g = 0; g < n; g += 5) {
+        RandomIt first = lo + g, last = lo + (g + 5 < n ? g + 5 : n);
+        insertion_sort(first, last, comp);
+        swap_elements(*store++, *(first + (last - first - 1) / 2));
+    }
+    RandomIt median = lo + (store - lo - 1) / 2;
+    __select(lo, store - 1, median, comp, true);
+    swap_elements(*lo, *median);
+}
+
+// 在 [lo, hi] 中选出第 nth 个元素 (introselect)
+// 先用三数取中切分, 切分次数超过 2 log n 仍未完成时改用中位数的中位数, linear 为真时一开始就用
+template <typename RandomIt, typename TComparer>
+void __select(RandomIt lo, RandomIt hi, RandomIt nth, TComparer comp, bool linear) {
+    size_t budget = 0;
+    for (size_t n = hi - lo + 1; n > 1; n /= 2) budget += 2;
+    while (hi > lo) {
+        if (hi - lo < 16) {
+            insertion_sort(lo, hi + 1, comp);
+            return;
+        }
+        if (linear || budget == 0) {
+            __median_of_medians_to_front(lo, hi, comp);
+            linear = true;
+        } else {
+            __median_of_three_to_front(lo, hi, comp);
+            --budget;
+        }
+        RandomIt j = __partition(lo, hi, comp);
+        if (j == nth) return;
+        if (j < nth)
+            lo = j + 1;
+        else
+            hi = j - 1;
+    }
+}
+
+// 重新排列 [first, last), 使 nth 处恰好是排序后应在该处的元素,
+// 并且它之前的元素都不大于它, 之后的元素都不小于它. 平均和最坏都是 O(n)
+template <typename RandomIt, typename TComparer>
+void nth_element(RandomIt first, RandomIt nth, RandomIt last, TComparer comp) {
+    if (last - first < 2 || nth == last) return;
+    __select(first, last - 1, nth, comp, false);
+}
+template <typename RandomIt>
+inline void nth_element(RandomIt first, RandomIt nth, RandomIt last) {
+    alg::nth_element(first, nth, last,
+                     compare_asc<typename std::iterator_traits<RandomIt>::value_type>);
+}
+
+// 使 [first, middle) 为整个序列中最小的 middle - first 个元素并有序, O(n + k log k)
+template <typename RandomIt, typename TComparer>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last, TComparer comp) {
+    if (middle == first) return;
+    alg::nth_element(first, middle - 1, last, comp);
+    heap_sort(first, middle - 1, comp);
+}
+template <typename RandomIt>
+inline void partial_sort(RandomIt first, RandomIt middle, RandomIt last) {
+    alg::partial_sort(first, middle, last,
+                      compare_asc<typename std::iterator_traits<RandomIt>::value_type>);
+}
+
+}  // namespace alg
@@ -10,7 +10,7 @@ namespace alg {
 template <typename ForwardIt, typename TComparer>
 void selection_sort(ForwardIt first, ForwardIt last, TComparer comp) {
     for (; first != last; ++first) {
-        std::swap(*first, *std::min_element(first, last, comp));
+        swap_elements(*first, *std::min_element(first, last, comp));
     }
 }
 template <typename ForwardIt>
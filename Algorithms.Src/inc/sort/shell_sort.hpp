@@ -17,7 +17,7 @@ void shell_sort(Array<T, N>& arr, TComparer comp) {
         for (size_t i = gap; i != arr.size(); ++i) {
             for (size_t j = i; j >= gap && lt(arr[j], arr[j - gap], comp);
                  j -= gap) {
-                std::swap(arr[j], arr[j - gap]);
+                swap_elements(arr[j], arr[j - gap]);
             }
         }
         gap /= 3;
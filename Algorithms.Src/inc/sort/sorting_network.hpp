@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "array.hpp"
+#include "sort/tim_sort.hpp"
+#include "utility.hpp"
+
+namespace alg {
+
+// 排序网络: 比较交换的顺序只与 N 有关, 与数据无关, 因此可以在编译期完全展开, 没有分支
+// 网络由 Batcher 的归并交换算法 (Knuth 5.2.2 算法 M) 在编译期生成, 适用于任意 N;
+// N = 4, 8 时是最优的, N = 16, 32 时分别为 63, 191 次比较 (已知最优为 60, 185)
+
+constexpr size_t __NETWORK_MAX_SIZE = 32;
+
+struct __CompareExchange {
+    unsigned char lo, hi;
+};
+template <size_t K>
+struct __Network {
+    __CompareExchange ops[K == 0 ? 1 : K] = {};
+};
+
+// 按算法 M 枚举所有比较交换 (i, i + d), visit 返回 false 时只计数
+template <typename TVisit>
+constexpr void __batcher_merge_exchange(size_t n, TVisit visit) {
+    if (n < 2) return;
+    size_t t = 0;
+    while ((size_t(1) << t) < n) ++t;
+    for (size_t p = size_t(1) << (t - 1); p > 0; p /= 2) {
+        size_t q = size_t(1) << (t - 1), r = 0, d = p;
+        while (true) {
+            for (size_t i = 0; i + d < n; ++i) {
+                if ((i & p) == r) visit(i, i + d);
+            }
+            if (q == p) break;
+            d = q - p;
+            q /= 2;
+            r = p;
+        }
+    }
+}
+template <size_t N>
+constexpr size_t __network_size() {
+    size_t k = 0;
+    __batcher_merge_exchange(N, [&k](size_t, size_t) { ++k; });
+    return k;
+}
+template <size_t N>
+constexpr __Network<__network_size<N>()> __make_network() {
+    __Network<__network_size<N>()> network;
+    size_t k = 0;
+    __batcher_merge_exchange(N, [&network, &k](size_t lo, size_t hi) {
+        network.ops[k].lo = static_cast<unsigned char>(lo);
+        network.ops[k].hi = static_cast<unsigned char>(hi);
+        ++k;
+    });
+    return network;
+}
+template <size_t N>
+inline constexpr auto __network_v = __make_network<N>();
+
+// 使 a 不大于 b. 算术类型用两次条件选择代替分支, 编译器生成 cmov 或 min/max 指令
+template <typename T, typename TComparer>
+constexpr void __compare_exchange(T &a, T &b, TComparer comp) {
+    if constexpr (std::is_arithmetic_v<T> || std::is_pointer_v<T>) {
+        bool swap = comp(b, a);
+        T lo = swap ? b : a;
+        T hi = swap ? a : b;
+        a = lo;
+        b = hi;
+    } else if (comp(b, a)) {
+        // std::swap 在 C++17 中不是 constexpr
+        T tmp = std::move(a);
+        a = std::move(b);
+        b = std::move(tmp);
+    }
+}
+template <size_t N, typename RandomIt, typename TComparer, size_t... Is>
+constexpr void __apply_network([[maybe_unused]] RandomIt first, [[maybe_unused]] TComparer comp,
+                               std::index_sequence<Is...>) {
+    (__compare_exchange(first[__network_v<N>.ops[Is].lo], first[__network_v<N>.ops[Is].hi], comp),
+     ...);
+}
+
+// 用排序网络对 [first, first + N) 排序, 不稳定
+template <size_t N, typename RandomIt, typename TComparer>
+constexpr void network_sort(RandomIt first, TComparer comp) {
+    static_assert(N <= __NETWORK_MAX_SIZE, "Sorting network is too large.");
+    __apply_network<N>(first, comp, std::make_index_sequence<__network_size<N>()>());
+}
+// 默认比较用函数对象而不是 compare_asc 的函数指针: 较大的网络不会整个内联到调用处,
+// 函数指针就成了每次比较都要做的间接调用 (N = 32 时慢约 8 倍, 比 std::sort 还慢约一倍)
+template <size_t N, typename RandomIt>
+constexpr void network_sort(RandomIt first) {
+    network_sort<N>(first, std::less<>());
+}
+
+// 定长数组排序: N 不超过 32 时展开为排序网络, 更大的 N 使用 tim_sort
+// 排序网络版本可以在 constexpr 函数中使用, 例如在编译期排序查找表
+template <typename T, size_t N, typename TComparer>
+constexpr void sort(Array<T, N> &arr, TComparer comp) {
+    if constexpr (N <= __NETWORK_MAX_SIZE)
+        network_sort<N>(arr.begin(), comp);
+    else
+        tim_sort(arr.begin(), arr.end(), comp);
+}
+template <typename T, size_t N>
+constexpr void sort(Array<T, N> &arr) {
+    sort(arr, std::less<>());
+}
+
+}  // namespace alg
@@ -0,0 +1,423 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "resizing_array.hpp"
+#include "utility.hpp"
+
+namespace alg {
+
+// TimSort: 自适应的稳定排序, 利用输入中已经存在的有序段 (run)
+// 已排序或逆序的输入只需 n - 1 次比较, 最坏仍是 O(n log n)
+
+constexpr std::ptrdiff_t __TIM_MIN_MERGE = 32;
+constexpr std::ptrdiff_t __TIM_MIN_GALLOP = 7;
+
+// 短于它的 run 用二分插入补齐, 使 n / min_run 接近且不超过 2 的幂, 归并时两边长度比较均衡
+inline std::ptrdiff_t __tim_min_run(std::ptrdiff_t n) {
+    std::ptrdiff_t r = 0;
+    while (n >= __TIM_MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+// 从 lo 开始的 run 的长度; 严格递减的 run 就地反转 (严格才能保证稳定)
+template <typename RandomIt, typename TComparer>
+std::ptrdiff_t __tim_count_run(RandomIt lo, RandomIt hi, TComparer comp) {
+    RandomIt run = lo + 1;
+    if (run == hi) return 1;
+    if (lt(*run, *lo, comp)) {
+        for (++run; run != hi && lt(*run, *(run - 1), comp); ++run) {}
+        std::reverse(lo, run);
+    } else {
+        for (++run; run != hi && !lt(*run, *(run - 1), comp); ++run) {}
+    }
+    return run - lo;
+}
+
+// [lo, start) 已经有序, 用二分查找把 [start, hi) 逐个插入, 比较次数为 O(n log n)
+template <typename RandomIt, typename TComparer>
+void __tim_binary_insertion_sort(RandomIt lo, RandomIt hi, RandomIt start, TComparer comp) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    for (; start != hi; ++start) {
+        value_type pivot = iter_move(start);
+        RandomIt left = lo, right = start;
+        while (left < right) {
+            RandomIt mid = left + (right - left) / 2;
+            if (lt(pivot, *mid, comp))
+                right = mid;
+            else
+                left = mid + 1;
+        }
+        move_elements_backward(left, start, start + 1);
+        *left = std::move(pivot);
+    }
+}
+
+// 在有序的 base[0, len) 中找 key 的插入位置, 从 hint 开始按 1, 3, 7, ... 的步长试探再二分
+// gallop_left 返回第一个不小于 key 的位置, gallop_right 返回第一个大于 key 的位置
+template <typename T, typename It, typename TComparer>
+std::ptrdiff_t __tim_gallop_left(const T &key, It base, std::ptrdiff_t len, std::ptrdiff_t hint,
+                                 TComparer comp) {
+    std::ptrdiff_t last_ofs = 0, ofs = 1;
+    if (lt(base[hint], key, comp)) {
+        std::ptrdiff_t max_ofs = len - hint;
+        while (ofs < max_ofs && lt(base[hint + ofs], key, comp)) {
+            last_ofs = ofs;
+            ofs = ofs * 2 + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    } else {
+        std::ptrdiff_t max_ofs = hint + 1;
+        while (ofs < max_ofs && !lt(base[hint - ofs], key, comp)) {
+            last_ofs = ofs;
+            ofs = ofs * 2 + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        std::ptrdiff_t tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    }
+    // 现在 base[last_ofs] < key <= base[ofs], 在 (last_ofs, ofs] 中二分
+    ++last_ofs;
+    while (last_ofs < ofs) {
+        std::ptrdiff_t m = last_ofs + (ofs - last_ofs) / 2;
+        if (lt(base[m], key, comp))
+            last_ofs = m + 1;
+        else
+            ofs = m;
+    }
+    return ofs;
+}
+template <typename T, typename It, typename TComparer>
+std::ptrdiff_t __tim_gallop_right(const T &key, It base, std::ptrdiff_t len, std::ptrdiff_t hint,
+                                  TComparer comp) {
+    std::ptrdiff_t last_ofs = 0, ofs = 1;
+    if (lt(key, base[hint], comp)) {
+        std::ptrdiff_t max_ofs = hint + 1;
+        while (ofs < max_ofs && lt(key, base[hint - ofs], comp)) {
+            last_ofs = ofs;
+            ofs = ofs * 2 + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        std::ptrdiff_t tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    } else {
+        std::ptrdiff_t max_ofs = len - hint;
+        while (ofs < max_ofs && !lt(key, base[hint + ofs], comp)) {
+            last_ofs = ofs;
+            ofs = ofs * 2 + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    }
+    // 现在 base[last_ofs] <= key < base[ofs], 在 (last_ofs, ofs] 中二分
+    ++last_ofs;
+    while (last_ofs < ofs) {
+        std::ptrdiff_t m = last_ofs + (ofs - last_ofs) / 2;
+        if (lt(key, base[m], comp))
+            ofs = m;
+        else
+            last_ofs = m + 1;
+    }
+    return ofs;
+}
+
+// 待归并的 run 栈以及归并用到的缓冲区
+// 栈中从底到顶的长度满足 len[i - 2] > len[i - 1] + len[i] 且 len[i - 1] > len[i],
+// 因此栈高为 O(log n), 并且每次归并的两个 run 长度相近
+template <typename RandomIt, typename TComparer>
+class __TimSortState {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    using diff_t = std::ptrdiff_t;
+
+public:
+    __TimSortState(RandomIt first, TComparer comp) : _a(first), _comp(comp) {}
+
+    void push_run(diff_t base, diff_t len) { _runs.push_back({base, len}); }
+    // 恢复栈的不变式, 注意要同时检查栈顶往下的三层 (只检查两层的原始版本在某些输入下会被破坏)
+    void merge_collapse() {
+        while (_runs.size() > 1) {
+            diff_t n = static_cast<diff_t>(_runs.size()) - 2;
+            if ((n > 0 && len(n - 1) <= len(n) + len(n + 1)) ||
+                (n > 1 && len(n - 2) <= len(n - 1) + len(n))) {
+                if (len(n - 1) < len(n + 1)) --n;
+            } else if (len(n) > len(n + 1)) {
+                break;
+            }
+            merge_at(n);
+        }
+    }
+    void merge_force_collapse() {
+        while (_runs.size() > 1) {
+            diff_t n = static_cast<diff_t>(_runs.size()) - 2;
+            if (n > 0 && len(n - 1) < len(n + 1)) --n;
+            merge_at(n);
+        }
+    }
+
+private:
+    struct Run {
+        diff_t base, len;
+    };
+
+    diff_t len(diff_t i) const { return _runs[i].len; }
+    // 归并栈中第 i 和 i + 1 个 run
+    void merge_at(diff_t i) {
+        diff_t base1 = _runs[i].base, len1 = _runs[i].len;
+        diff_t base2 = _runs[i + 1].base, len2 = _runs[i + 1].len;
+        _runs[i].len = len1 + len2;
+        if (i == static_cast<diff_t>(_runs.size()) - 3) _runs[i + 1] = _runs[i + 2];
+        _runs.pop_back();
+
+        // run1 中不大于 run2 首元素的前缀, 以及 run2 中不小于 run1 尾元素的后缀都已经就位
+        diff_t k = __tim_gallop_right(_a[base2], _a + base1, len1, 0, _comp);
+        base1 += k;
+        len1 -= k;
+        if (len1 == 0) return;
+        len2 = __tim_gallop_left(_a[base1 + len1 - 1], _a + base2, len2, len2 - 1, _comp);
+        if (len2 == 0) return;
+
+        if (len1 <= len2)
+            merge_lo(base1, len1, base2, len2);
+        else
+            merge_hi(base1, len1, base2, len2);
+    }
+    void fill_tmp(diff_t base, diff_t n) {
+        _tmp.clear();
+        _tmp.reserve(n);
+        for (diff_t i = 0; i != n; ++i) _tmp.push_back(iter_move(_a + (base + i)));
+    }
+    // 一方连续胜出 _min_gallop 次后进入 galloping 模式, 成段移动; 效果不好时退回逐个比较
+    // 结束时按 galloping 的成效调整门槛, 随机数据上很快就不再尝试
+    void end_gallop(diff_t min_gallop) { _min_gallop = min_gallop < 1 ? 1 : min_gallop; }
+    [[noreturn]] static void bad_comparer() {
+        throw std::invalid_argument("Comparison method violates its general contract.");
+    }
+
+    // len1 <= len2: 把 run1 移到缓冲区, 从前往后归并
+    void merge_lo(diff_t base1, diff_t len1, diff_t base2, diff_t len2) {
+        fill_tmp(base1, len1);
+        auto tmp = _tmp.begin();
+        diff_t cursor1 = 0, cursor2 = base2, dest = base1;
+        _a[dest++] = iter_move(_a + cursor2++);
+        if (--len2 == 0) {
+            std::move(tmp + cursor1, tmp + cursor1 + len1, _a + dest);
+            return;
+        }
+        if (len1 == 1) {
+            move_elements(_a + cursor2, _a + cursor2 + len2, _a + dest);
+            _a[dest + len2] = std::move(tmp[cursor1]);
+            return;
+        }
+        diff_t min_gallop = _min_gallop;
+        while (true) {
+            diff_t count1 = 0, count2 = 0;  // 两边各自连续胜出的次数
+            bool done = false;
+            do {
+                if (lt(_a[cursor2], tmp[cursor1], _comp)) {
+                    _a[dest++] = iter_move(_a + cursor2++);
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 0) done = true;
+                } else {
+                    _a[dest++] = std::move(tmp[cursor1++]);
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 1) done = true;
+                }
+            } while (!done && (count1 | count2) < min_gallop);
+            if (done) break;
+
+            do {
+                count1 = __tim_gallop_right(_a[cursor2], tmp + cursor1, len1, 0, _comp);
+                if (count1 != 0) {
+                    std::move(tmp + cursor1, tmp + cursor1 + count1, _a + dest);
+                    dest += count1;
+                    cursor1 += count1;
+                    len1 -= count1;
+                    if (len1 <= 1) {
+                        done = true;
+                        break;
+                    }
+                }
+                _a[dest++] = iter_move(_a + cursor2++);
+                if (--len2 == 0) {
+                    done = true;
+                    break;
+                }
+                count2 = __tim_gallop_left(tmp[cursor1], _a + cursor2, len2, 0, _comp);
+                if (count2 != 0) {
+                    move_elements(_a + cursor2, _a + cursor2 + count2, _a + dest);
+                    dest += count2;
+                    cursor2 += count2;
+                    len2 -= count2;
+                    if (len2 == 0) {
+                        done = true;
+                        break;
+                    }
+                }
+                _a[dest++] = std::move(tmp[cursor1++]);
+                if (--len1 == 1) {
+                    done = true;
+                    break;
+                }
+                --min_gallop;
+            } while (count1 >= __TIM_MIN_GALLOP || count2 >= __TIM_MIN_GALLOP);
+            if (done) break;
+            if (min_gallop < 0) min_gallop = 0;
+            min_gallop += 2;  // 退出 galloping 模式要付出代价
+        }
+        end_gallop(min_gallop);
+
+        if (len1 == 1) {
+            move_elements(_a + cursor2, _a + cursor2 + len2, _a + dest);
+            _a[dest + len2] = std::move(tmp[cursor1]);
+        } else if (len1 == 0) {
+            bad_comparer();
+        } else {
+            std::move(tmp + cursor1, tmp + cursor1 + len1, _a + dest);
+        }
+    }
+    // len1 > len2: 把 run2 移到缓冲区, 从后往前归并
+    void merge_hi(diff_t base1, diff_t len1, diff_t base2, diff_t len2) {
+        fill_tmp(base2, len2);
+        auto tmp = _tmp.begin();
+        diff_t cursor1 = base1 + len1 - 1, cursor2 = len2 - 1, dest = base2 + len2 - 1;
+        _a[dest--] = iter_move(_a + cursor1--);
+        if (--len1 == 0) {
+            std::move(tmp, tmp + len2, _a + (dest - (len2 - 1)));
+            return;
+        }
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            move_elements_backward(_a + (cursor1 + 1), _a + (cursor1 + 1 + len1),
+                                   _a + (dest + 1 + len1));
+            _a[dest] = std::move(tmp[cursor2]);
+            return;
+        }
+        diff_t min_gallop = _min_gallop;
+        while (true) {
+            diff_t count1 = 0, count2 = 0;
+            bool done = false;
+            do {
+                if (lt(tmp[cursor2], _a[cursor1], _comp)) {
+                    _a[dest--] = iter_move(_a + cursor1--);
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 0) done = true;
+                } else {
+                    _a[dest--] = std::move(tmp[cursor2--]);
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 1) done = true;
+                }
+            } while (!done && (count1 | count2) < min_gallop);
+            if (done) break;
+
+            do {
+                count1 = len1 - __tim_gallop_right(tmp[cursor2], _a + base1, len1, len1 - 1, _comp);
+                if (count1 != 0) {
+                    dest -= count1;
+                    cursor1 -= count1;
+                    len1 -= count1;
+                    move_elements_backward(_a + (cursor1 + 1), _a + (cursor1 + 1 + count1),
+                                           _a + (dest + 1 + count1));
+                    if (len1 == 0) {
+                        done = true;
+                        break;
+                    }
+                }
+                _a[dest--] = std::move(tmp[cursor2--]);
+                if (--len2 == 1) {
+                    done = true;
+                    break;
+                }
+                count2 = len2 - __tim_gallop_left(_a[cursor1], tmp, len2, len2 - 1, _comp);
+                if (count2 != 0) {
+                    dest -= count2;
+                    cursor2 -= count2;
+                    len2 -= count2;
+                    std::move(tmp + (cursor2 + 1), tmp + (cursor2 + 1 + count2), _a + (dest + 1));
+                    if (len2 <= 1) {
+                        done = true;
+                        break;
+                    }
+                }
+                _a[dest--] = iter_move(_a + cursor1--);
+                if (--len1 == 0) {
+                    done = true;
+                    break;
+                }
+                --min_gallop;
+            } while (count1 >= __TIM_MIN_GALLOP || count2 >= __TIM_MIN_GALLOP);
+            if (done) break;
+            if (min_gallop < 0) min_gallop = 0;
+            min_gallop += 2;
+        }
+        end_gallop(min_gallop);
+
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            move_elements_backward(_a + (cursor1 + 1), _a + (cursor1 + 1 + len1),
+                                   _a + (dest + 1 + len1));
+            _a[dest] = std::move(tmp[cursor2]);
+        } else if (len2 == 0) {
+            bad_comparer();
+        } else {
+            std::move(tmp, tmp + len2, _a + (dest - (len2 - 1)));
+        }
+    }
+
+private:
+    RandomIt _a;
+    TComparer _comp;
+    diff_t _min_gallop = __TIM_MIN_GALLOP;
+    ResizingArray<Run> _runs;
+    ResizingArray<value_type> _tmp;
+};
+
+template <typename RandomIt, typename TComparer>
+void tim_sort(RandomIt first, RandomIt last, TComparer comp) {
+    std::ptrdiff_t remaining = last - first;
+    if (remaining < 2) return;
+    // 较短时不做归并, 只需一个 run 加二分插入
+    if (remaining < __TIM_MIN_MERGE) {
+        std::ptrdiff_t run = __tim_count_run(first, last, comp);
+        __tim_binary_insertion_sort(first, last, first + run, comp);
+        return;
+    }
+    __TimSortState<RandomIt, TComparer> state(first, comp);
+    std::ptrdiff_t min_run = __tim_min_run(remaining), lo = 0;
+    do {
+        std::ptrdiff_t run = __tim_count_run(first + lo, last, comp);
+        if (run < min_run) {
+            std::ptrdiff_t force = remaining < min_run ? remaining : min_run;
+            __tim_binary_insertion_sort(first + lo, first + lo + force, first + lo + run, comp);
+            run = force;
+        }
+        state.push_run(lo, run);
+        state.merge_collapse();
+        lo += run;
+        remaining -= run;
+    } while (remaining != 0);
+    state.merge_force_collapse();
+}
+template <typename RandomIt>
+inline void tim_sort(RandomIt first, RandomIt last) {
+    tim_sort(first, last, compare_asc<typename std::iterator_traits<RandomIt>::value_type>);
+}
+
+}  // namespace alg
@@ -36,11 +36,11 @@ public:
 
 public:
     value_type pop() {
-        value_type result = _container.back();
+        value_type result = std::move(_container.back());
         _container.pop_back();
         return result;
     }
-    void push(value_type &value) { _container.push_back(value); }
+    void push(const value_type &value) { _container.push_back(value); }
     void push(value_type &&value) {
         _container.push_back(std::forward<value_type>(value));
     }
@@ -1,7 +1,21 @@
 #pragma once
 #include <string>
+#include <string_view>
 
 namespace alg {
-std::string::size_type utf8_walk_length(const std::string &str);
+// 统计码点个数, 按运行时检测到的指令集 (AVX-512BW / AVX2 / SSE2) 每次处理 16~64 字节
+std::string::size_type utf8_walk_length(std::string_view str);
+std::string::size_type utf8_walk_length(const char *data, std::string::size_type n);
 std::string utf8_char_at(const std::string &str, std::string::size_type idx);
+
+// 按 RFC 3629 严格校验 (拒绝截断, 多余的延续字节, 超长编码, 代理区和 U+10FFFF 以上的码点)
+// 合法时返回 npos, 否则返回第一个非法序列的起始字节位置
+std::string::size_type utf8_validate(std::string_view str);
+
+// 转码结果写入 out (覆盖原内容); 成功时返回 npos,
+// 否则返回输入中第一个非法序列的起始位置 (以输入的码元计), out 中保留出错前已转换的部分
+std::string::size_type utf8_to_utf16(std::string_view str, std::u16string &out);
+std::string::size_type utf8_to_utf32(std::string_view str, std::u32string &out);
+std::string::size_type utf16_to_utf8(std::u16string_view str, std::string &out);
+std::string::size_type utf32_to_utf8(std::u32string_view str, std::string &out);
 }  // namespace alg
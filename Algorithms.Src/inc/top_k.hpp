@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "sort/select.hpp"
+#include "vector.hpp"
+
+namespace alg {
+
+// 在数据流中保留按 comp 最大的 k 个元素, 不需要保存整个数据流
+// 元素先追加到容量为 2k 的缓冲区, 满了以后用 nth_element 留下最大的 k 个, 并把其中最小的记为门槛;
+// 之后不大于门槛的元素直接丢弃. 每个元素的均摊代价为 O(1), 绝大多数元素只需一次比较
+template <typename T, typename TComparer = std::less<T>>
+class TopK {
+public:
+    using value_type = T;
+    using size_type = size_t;
+
+public:
+    explicit TopK(size_type k, TComparer comp = TComparer()) : _k(k), _comp(comp) {
+        _buffer.reserve(2 * k);
+    }
+
+public:
+    void push(const T &value) {
+        if (_k == 0 || (_filtering && !_comp(_buffer[_k - 1], value))) return;
+        _buffer.push_back(value);
+        if (_buffer.size() == 2 * _k) compact();
+    }
+    template <typename InputIt>
+    void push(InputIt first, InputIt last) {
+        for (; first != last; ++first) push(*first);
+    }
+    void clear() {
+        _buffer.clear();
+        _filtering = false;
+    }
+
+public:
+    // 目前最大的至多 k 个元素, 从大到小排列
+    Vector<T> result() const {
+        Vector<T> items = _buffer;
+        auto greater = reversed();
+        size_type k = items.size() < _k ? items.size() : _k;
+        alg::partial_sort(items.begin(), items.begin() + k, items.end(), greater);
+        items.erase(items.begin() + k, items.end());
+        return items;
+    }
+    // 进入结果所需超过的门槛, 还没有丢弃过元素时返回空指针
+    const T *threshold() const noexcept { return _filtering ? &_buffer[_k - 1] : nullptr; }
+    size_type k() const noexcept { return _k; }
+
+private:
+    auto reversed() const {
+        TComparer comp = _comp;
+        return [comp](const T &lhs, const T &rhs) { return comp(rhs, lhs); };
+    }
+    // 留下最大的 k 个, 第 k 大的放在 _buffer[k - 1] 作为门槛
+    void compact() {
+        alg::nth_element(_buffer.begin(), _buffer.begin() + (_k - 1), _buffer.end(), reversed());
+        _buffer.erase(_buffer.begin() + _k, _buffer.end());
+        _filtering = true;
+    }
+
+private:
+    size_type _k;
+    TComparer _comp;
+    Vector<T> _buffer;
+    bool _filtering = false;
+};
+
+}  // namespace alg
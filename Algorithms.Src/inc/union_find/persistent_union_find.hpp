@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mapped_file.hpp"
+
+namespace alg {
+
+// 可以保存到文件, 并通过内存映射直接重新打开的并查集 (按秩合并)
+// 文件格式 (小端):
+//   64 字节的文件头: 魔数 "ALGUNION", 版本, 下标字节数, 节点数, 连通分量数, 两个数组的偏移
+//   parent 数组 (每项 4 字节), rank 数组 (每项 1 字节), 两个数组都按 64 字节对齐
+// open 只检查文件头, 之后的查询直接读取映射的页面, 不需要解析或复制;
+// 映射是写时复制的, 打开后的 connect 只修改本进程的副本, 需要持久化时再 save
+class PersistentUnionFind {
+public:
+    using index_type = uint32_t;
+    static constexpr uint32_t VERSION = 1;
+
+public:
+    // 在内存中创建 n 个互不连通的节点
+    explicit PersistentUnionFind(size_t n);
+    // 文件不存在, 格式或版本不符时抛出 std::runtime_error
+    static PersistentUnionFind open(const std::string &path);
+
+public:
+    // 先写到临时文件再改名, 写入过程中出错不会破坏原有的文件
+    void save(const std::string &path) const;
+    bool connect(size_t n1, size_t n2);
+    bool is_connected(size_t n1, size_t n2) const;
+    // 不做路径压缩, 查询不写入映射的页面; 按秩合并保证树高不超过 log n
+    // 父节点数组损坏 (越界或成环) 时抛出 std::runtime_error
+    size_t find_root(size_t i) const;
+    size_t count() const noexcept { return _count; }
+    size_t size() const noexcept { return _size; }
+    bool is_mapped() const noexcept { return _file.is_open(); }
+
+private:
+    PersistentUnionFind() = default;
+
+private:
+    index_type *_parent = nullptr;
+    unsigned char *_rank = nullptr;
+    size_t _size = 0;
+    size_t _count = 0;
+    // 两种存储方式之一: 在堆上创建, 或者映射自文件
+    std::vector<index_type> _heap_parent;
+    std::vector<unsigned char> _heap_rank;
+    MappedFile _file;
+};
+
+}  // namespace alg
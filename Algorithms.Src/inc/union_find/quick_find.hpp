@@ -1,21 +1,62 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <numeric>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
+#include "huge_page_allocator.hpp"
+
 namespace alg {
 
-class QuickFind {
+// 每个节点直接记录所在分量的编号: 查询 O(1), 合并 O(n)
+// TIndex 为存储下标的无符号整数类型, 节点很多时用 uint64_t, 否则 uint32_t 更省内存
+template <typename TIndex>
+class BasicQuickFind {
+    static_assert(std::is_unsigned_v<TIndex>, "Index type must be unsigned.");
+
+public:
+    using index_type = TIndex;
+
 public:
-    QuickFind(size_t n);
+    explicit BasicQuickFind(size_t n) : _map(checked_size(n)) {
+        std::iota(_map.begin(), _map.end(), TIndex(0));
+    }
 
 public:
-    void connect(size_t n1, size_t n2);
-    bool is_connected(size_t n1, size_t n2);
+    void connect(size_t n1, size_t n2) {
+        assert(n1 < _map.size() && n2 < _map.size());
+        TIndex v1 = _map[n1];
+        TIndex v2 = _map[n2];
+        if (v1 == v2) return;
+        for (TIndex &val : _map) {
+            if (val == v1) val = v2;
+        }
+    }
+    bool is_connected(size_t n1, size_t n2) const {
+        assert(n1 < _map.size() && n2 < _map.size());
+        return _map[n1] == _map[n2];
+    }
+    size_t size() const noexcept { return _map.size(); }
 
 private:
-    std::vector<int> _map;
+    // 在分配 _map 之前检查, 否则过大的 n 会先因为分配失败抛出 bad_alloc
+    // 存放的是 [0, n) 中的下标, 所以 n 可以比 TIndex 的最大值大 1
+    static size_t checked_size(size_t n) {
+        if (n != 0 && n - 1 > std::numeric_limits<TIndex>::max()) {
+            throw std::invalid_argument("Too many nodes for the index type.");
+        }
+        return n;
+    }
+
+private:
+    std::vector<TIndex, HugePageAllocator<TIndex>> _map;
 };
 
+using QuickFind = BasicQuickFind<uint32_t>;
+using QuickFind64 = BasicQuickFind<uint64_t>;
+
 }  // namespace alg
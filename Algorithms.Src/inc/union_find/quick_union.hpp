@@ -1,23 +1,69 @@
 #pragma once
 
-#include <cstdlib>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "huge_page_allocator.hpp"
+
 namespace alg {
 
-class QuickUnion {
+// 森林表示的并查集, 按秩合并并在查找时做路径减半
+// 秩不单独存放: 根节点的项最高位为 1, 其余位存秩 (不超过 log n); 非根节点的项是父节点的下标
+// 因此每个节点只占一个 TIndex, 节点数不能超过 2^(位数 - 1), uint32_t 时约 21 亿
+template <typename TIndex>
+class BasicQuickUnion {
+    static_assert(std::is_unsigned_v<TIndex>, "Index type must be unsigned.");
+
 public:
-    QuickUnion(size_t n);
+    using index_type = TIndex;
+    static constexpr TIndex ROOT_BIT = TIndex(1) << (std::numeric_limits<TIndex>::digits - 1);
 
 public:
-    void connect(size_t n1, size_t n2);
-    bool is_connected(size_t n1, size_t n2);
+    explicit BasicQuickUnion(size_t n) : _map(checked_size(n), ROOT_BIT) {}
+
+public:
+    void connect(size_t n1, size_t n2) {
+        TIndex r1 = find_root(n1), r2 = find_root(n2);
+        if (r1 == r2) return;
+        // 秩小的树挂到秩大的树下, 秩相同时新根的秩加一
+        if (rank(r1) > rank(r2)) std::swap(r1, r2);
+        bool same = rank(r1) == rank(r2);
+        _map[r1] = r2;
+        if (same) ++_map[r2];
+    }
+    bool is_connected(size_t n1, size_t n2) { return find_root(n1) == find_root(n2); }
+    size_t size() const noexcept { return _map.size(); }
 
 private:
-    int find_root(int i);
+    // 在分配 _map 之前检查, 否则过大的 n 会先因为分配失败抛出 bad_alloc
+    static size_t checked_size(size_t n) {
+        if (n > ROOT_BIT) throw std::invalid_argument("Too many nodes for the index type.");
+        return n;
+    }
+    bool is_root(TIndex i) const noexcept { return (_map[i] & ROOT_BIT) != 0; }
+    TIndex rank(TIndex root) const noexcept { return _map[root] & ~ROOT_BIT; }
+    // 路径减半: 沿途每个节点改为指向祖父节点
+    TIndex find_root(size_t i) {
+        assert(i < _map.size());
+        TIndex x = static_cast<TIndex>(i);
+        while (!is_root(x)) {
+            TIndex parent = _map[x];
+            if (!is_root(parent)) _map[x] = _map[parent];
+            x = _map[x];
+        }
+        return x;
+    }
 
 private:
-    std::vector<int> _map;
+    std::vector<TIndex, HugePageAllocator<TIndex>> _map;
 };
 
+using QuickUnion = BasicQuickUnion<uint32_t>;
+using QuickUnion64 = BasicQuickUnion<uint64_t>;
+
 }  // namespace alg
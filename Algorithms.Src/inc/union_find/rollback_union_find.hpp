@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace alg {
+
+// 可撤销的并查集: 按秩合并, 不做路径压缩, 因此每次合并只修改两个位置, 可以按相反顺序撤销
+// find_root 为 O(log n); snapshot 记下当前位置, rollback 撤销其后的合并, 每次撤销 O(1)
+class RollbackUnionFind {
+public:
+    explicit RollbackUnionFind(size_t n);
+
+public:
+    // 合并 n1 和 n2 所在的集合, 它们原本就连通时返回 false 且不记录
+    bool connect(size_t n1, size_t n2);
+    bool is_connected(size_t n1, size_t n2) const;
+    size_t find_root(size_t i) const;
+    size_t count() const noexcept { return _count; }
+    size_t size() const noexcept { return _parent.size(); }
+
+    // 日志的当前长度, 之后可以用 rollback 回到这里
+    size_t snapshot() const noexcept { return _log.size(); }
+    void rollback(size_t to);
+
+private:
+    struct Change {
+        size_t child;       // 被挂到另一棵树下的根
+        bool rank_raised;   // 新根的秩是否加了一
+    };
+
+private:
+    std::vector<size_t> _parent;
+    std::vector<unsigned char> _rank;
+    std::vector<Change> _log;
+    size_t _count;
+};
+
+// 离线动态连通性: 边在时刻区间 [added, removed) 内存在, 询问某一时刻两点是否连通
+struct TimedEdge {
+    size_t n1, n2;
+    size_t added, removed;
+};
+struct ConnectivityQuery {
+    size_t n1, n2;
+    size_t time;
+};
+
+// 在排序去重后的 T 个询问时刻上建线段树, 每条边挂到覆盖其存在区间的 O(log T) 个节点上;
+// 深度优先遍历时进入节点就合并其上的边, 离开时回滚. 总时间 O((m log T + q) log n)
+std::vector<bool> dynamic_connectivity(size_t n, const std::vector<TimedEdge> &edges,
+                                       const std::vector<ConnectivityQuery> &queries);
+
+}  // namespace alg
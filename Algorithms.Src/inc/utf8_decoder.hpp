@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace alg {
+
+// 增量 UTF-8 解码器: 数据可以按任意大小分块送入, 跨块的多字节序列会被保留到下一块继续解码
+// 只保存当前序列的状态, 占用常数内存; 校验规则与 utf8_validate 相同, 出错时抛出
+// std::invalid_argument
+class Utf8Decoder {
+public:
+    using size_type = std::string::size_type;
+
+public:
+    // 对 chunk 中每个完整的码点调用 f(char32_t)
+    template <typename F>
+    void decode(std::string_view chunk, F f);
+    // 只统计码点个数和边界, 不关心码点的值
+    void feed(std::string_view chunk) {
+        decode(chunk, [](char32_t) {});
+    }
+    // 输入结束, 如果最后一个序列不完整则抛出异常
+    void finish() const {
+        if (_remaining != 0) fail();
+    }
+    void reset() noexcept { *this = Utf8Decoder(); }
+
+public:
+    // 到目前为止完整解码的码点个数
+    size_type code_points() const noexcept { return _code_points; }
+    // 到目前为止读入的字节数
+    size_type bytes() const noexcept { return _bytes; }
+    // 尚未完成的序列已经读入的字节数; 对刚送入的 chunk, chunk.size() - pending_bytes() 即为
+    // 其中最后一个码点边界 (pending_bytes() 大于 chunk.size() 时该序列开始于更早的块)
+    size_type pending_bytes() const noexcept { return _remaining == 0 ? 0 : _bytes - _start; }
+
+private:
+    [[noreturn]] void fail() const {
+        throw std::invalid_argument("Not a standard UTF-8 string: invalid sequence at byte " +
+                                    std::to_string(_start) + ".");
+    }
+
+private:
+    size_type _code_points = 0;
+    size_type _bytes = 0;
+    size_type _start = 0;  // 当前序列第一个字节的位置
+    char32_t _cp = 0;
+    unsigned char _remaining = 0;  // 当前序列还缺几个延续字节
+    unsigned char _lo = 0x80, _hi = 0xBF;  // 下一个延续字节的取值范围
+};
+
+template <typename F>
+void Utf8Decoder::decode(std::string_view chunk, F f) {
+    const unsigned char *s = reinterpret_cast<const unsigned char *>(chunk.data());
+    size_type n = chunk.size(), i = 0;
+    while (i < n) {
+        if (_remaining == 0) {
+            // 连续 8 个 ASCII 字节一次判断
+            if (n - i >= 8) {
+                std::uint64_t word;
+                std::memcpy(&word, s + i, 8);
+                if ((word & 0x8080808080808080ull) == 0) {
+                    for (size_type k = 0; k != 8; ++k) f(static_cast<char32_t>(s[i + k]));
+                    i += 8;
+                    _bytes += 8;
+                    _code_points += 8;
+                    continue;
+                }
+            }
+            unsigned char b = s[i++];
+            _start = _bytes++;
+            if (b < 0x80) {
+                f(static_cast<char32_t>(b));
+                ++_code_points;
+                continue;
+            }
+            _lo = 0x80;
+            _hi = 0xBF;
+            if (b >= 0xC2 && b <= 0xDF) {
+                _remaining = 1;
+                _cp = b & 0x1F;
+            } else if (b >= 0xE0 && b <= 0xEF) {
+                _remaining = 2;
+                _cp = b & 0x0F;
+                if (b == 0xE0) _lo = 0xA0;
+                else if (b == 0xED) _hi = 0x9F;
+            } else if (b >= 0xF0 && b <= 0xF4) {
+                _remaining = 3;
+                _cp = b & 0x07;
+                if (b == 0xF0) _lo = 0x90;
+                else if (b == 0xF4) _hi = 0x8F;
+            } else {
+                fail();
+            }
+        } else {
+            unsigned char b = s[i];
+            if (b < _lo || b > _hi) fail();
+            ++i;
+            ++_bytes;
+            _cp = (_cp << 6) | (b & 0x3F);
+            _lo = 0x80;
+            _hi = 0xBF;
+            if (--_remaining == 0) {
+                f(_cp);
+                ++_code_points;
+            }
+        }
+    }
+}
+
+}  // namespace alg
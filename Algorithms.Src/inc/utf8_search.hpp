@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "string.hpp"
+
+namespace alg {
+
+// 一次匹配的结果, 同时给出字节偏移和码点偏移; 未找到时均为 npos
+struct Utf8Match {
+    static constexpr std::string::size_type npos = std::string::npos;
+
+    std::string::size_type byte_offset = npos;
+    std::string::size_type char_offset = npos;
+    std::string::size_type needle = 0;  // Utf8MultiSearcher 中匹配到的模式下标
+
+    explicit operator bool() const noexcept { return byte_offset != npos; }
+};
+
+// 针对一个模式串预处理一次, 之后可以在多个文本中查找
+// 有 AVX2 / SSE2 时先用模式的首尾字节在 32 / 16 个位置上同时筛选候选, 再比较中间部分;
+// 否则 (以及筛选剩下的尾部) 使用 Boyer-Moore-Horspool
+// UTF-8 是自同步的, 合法模式在合法文本中的匹配位置一定落在码点边界上
+class Utf8Searcher {
+public:
+    using size_type = std::string::size_type;
+    static constexpr size_type npos = std::string::npos;
+
+public:
+    explicit Utf8Searcher(std::string needle);
+
+public:
+    // 第一个匹配
+    Utf8Match find(std::string_view haystack) const;
+    // 依次对每个不重叠的匹配调用 f(const Utf8Match &), 码点偏移随扫描累加, 不会重复计算前缀
+    template <typename F>
+    void find_all(std::string_view haystack, F f) const;
+    // 从字节位置 pos 开始查找, 返回匹配的字节偏移或 npos
+    size_type find_bytes(std::string_view haystack, size_type pos = 0) const;
+
+public:
+    const std::string &needle() const noexcept { return _needle; }
+
+private:
+    size_type find_horspool(const char *haystack, size_type n) const;
+
+private:
+    std::string _needle;
+    size_type _shift[256];  // Horspool 坏字符表
+};
+
+// 同时查找少量模式串, 返回最靠左的匹配 (位置相同时取下标较小的模式)
+// 每个模式记住自己下一个匹配的位置, 只有被越过的模式才重新查找, 整体仍是一遍扫描
+class Utf8MultiSearcher {
+public:
+    using size_type = std::string::size_type;
+    static constexpr size_type npos = std::string::npos;
+
+public:
+    explicit Utf8MultiSearcher(const std::vector<std::string> &needles);
+
+public:
+    Utf8Match find(std::string_view haystack) const;
+    template <typename F>
+    void find_all(std::string_view haystack, F f) const;
+
+public:
+    size_type size() const noexcept { return _searchers.size(); }
+
+private:
+    std::vector<Utf8Searcher> _searchers;
+};
+
+template <typename F>
+void Utf8Searcher::find_all(std::string_view haystack, F f) const {
+    size_type pos = 0, counted = 0, chars = 0;
+    while ((pos = find_bytes(haystack, pos)) != npos) {
+        chars += utf8_walk_length(haystack.data() + counted, pos - counted);
+        counted = pos;
+        f(Utf8Match{pos, chars, 0});
+        pos += _needle.empty() ? 1 : _needle.size();
+        if (pos > haystack.size()) break;
+    }
+}
+
+template <typename F>
+void Utf8MultiSearcher::find_all(std::string_view haystack, F f) const {
+    std::vector<size_type> next(_searchers.size());
+    for (size_type k = 0; k != _searchers.size(); ++k) next[k] = _searchers[k].find_bytes(haystack);
+    size_type counted = 0, chars = 0;
+    while (true) {
+        size_type best = 0;
+        for (size_type k = 1; k < next.size(); ++k) {
+            if (next[k] < next[best]) best = k;
+        }
+        if (next.empty() || next[best] == npos) return;
+        size_type pos = next[best];
+        chars += utf8_walk_length(haystack.data() + counted, pos - counted);
+        counted = pos;
+        f(Utf8Match{pos, chars, best});
+        size_type len = _searchers[best].needle().size();
+        size_type resume = pos + (len == 0 ? 1 : len);
+        for (size_type k = 0; k != next.size(); ++k) {
+            if (next[k] != npos && next[k] < resume) {
+                next[k] = resume > haystack.size() ? npos
+                                                   : _searchers[k].find_bytes(haystack, resume);
+            }
+        }
+    }
+}
+
+}  // namespace alg
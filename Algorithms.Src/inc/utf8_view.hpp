@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace alg {
+
+// 不持有数据的 UTF-8 字符串视图, 按码点下标访问
+// 第一次随机访问时才按需建立稀疏索引 (每 INDEX_STRIDE 个码点记录一次字节偏移),
+// 之后 char_at 只需从最近的检查点向后走不超过 INDEX_STRIDE - 1 个码点
+// 与标准容器一样, 同一个对象不能在多个线程中同时使用
+class Utf8View {
+public:
+    using size_type = std::string_view::size_type;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view *;
+        using reference = std::string_view;
+
+    public:
+        const_iterator() = default;
+
+    public:
+        std::string_view operator*() const;
+        const_iterator &operator++();
+        const_iterator &operator--();
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        bool operator==(const const_iterator &rhs) const { return _pos == rhs._pos; }
+        bool operator!=(const const_iterator &rhs) const { return _pos != rhs._pos; }
+
+    public:
+        // 当前码点在原字符串中的字节偏移
+        size_type byte_offset() const noexcept { return _pos; }
+
+    private:
+        const_iterator(std::string_view str, size_type pos) : _str(str), _pos(pos) {}
+
+    private:
+        std::string_view _str;
+        size_type _pos = 0;
+
+        friend class Utf8View;
+    };
+    using iterator = const_iterator;
+
+public:
+    static constexpr size_type npos = std::string_view::npos;
+    static constexpr size_type INDEX_STRIDE = 64;
+
+public:
+    Utf8View() = default;
+    Utf8View(std::string_view str) : _str(str) {}
+    Utf8View(const std::string &str) : _str(str) {}
+    Utf8View(const char *str) : _str(str) {}
+
+public:
+    std::string_view operator[](size_type idx) const { return char_at(idx); }
+
+public:
+    std::string_view char_at(size_type idx) const;
+    // 第 idx 个码点的字节偏移, idx == size() 时返回字节长度
+    size_type byte_offset(size_type idx) const;
+    // 按码点截取 [pos, pos + count)
+    Utf8View substr(size_type pos, size_type count = npos) const;
+
+public:
+    const_iterator begin() const noexcept { return const_iterator(_str, 0); }
+    const_iterator end() const noexcept { return const_iterator(_str, _str.size()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+public:
+    size_type size() const;
+    bool empty() const noexcept { return _str.empty(); }
+    std::string_view bytes() const noexcept { return _str; }
+
+private:
+    // 从最近的检查点走到第 idx 个码点, 返回其字节偏移; idx > size() 时返回 npos
+    size_type walk_to(size_type idx) const;
+
+private:
+    std::string_view _str;
+    mutable std::vector<size_type> _index;  // _index[k] 为第 k * INDEX_STRIDE 个码点的字节偏移
+    mutable bool _index_complete = false;
+    mutable size_type _size = npos;
+};
+
+inline bool operator==(const Utf8View &lhs, const Utf8View &rhs) {
+    return lhs.bytes() == rhs.bytes();
+}
+inline bool operator!=(const Utf8View &lhs, const Utf8View &rhs) { return !(lhs == rhs); }
+
+}  // namespace alg
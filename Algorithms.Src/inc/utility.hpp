@@ -1,47 +1,90 @@
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
 namespace alg {
 
+// 把 *it 作为右值取出, 用于把元素移出序列或移入别处
+// 代理迭代器 (如 ZipIterator) 的 *it 是临时对象, std::move(*it) 无法区分移动和复制,
+// 它们通过 ADL 提供自己的 iter_move, 因此调用时不要加 alg:: 限定
+template <typename It>
+inline decltype(auto) iter_move(const It &it) {
+    if constexpr (std::is_lvalue_reference_v<decltype(*it)>)
+        return std::move(*it);
+    else
+        return *it;
+}
+
+// 与 std::move / std::move_backward 相同, 但代理迭代器通过 iter_move 移动元素
+template <typename InputIt, typename OutputIt>
+inline OutputIt move_elements(InputIt first, InputIt last, OutputIt dest) {
+    if constexpr (std::is_lvalue_reference_v<decltype(*first)>) {
+        return std::move(first, last, dest);
+    } else {
+        for (; first != last; ++first, ++dest) *dest = iter_move(first);
+        return dest;
+    }
+}
+template <typename BidIt1, typename BidIt2>
+inline BidIt2 move_elements_backward(BidIt1 first, BidIt1 last, BidIt2 dest) {
+    if constexpr (std::is_lvalue_reference_v<decltype(*first)>) {
+        return std::move_backward(first, last, dest);
+    } else {
+        while (first != last) *--dest = iter_move(--last);
+        return dest;
+    }
+}
+
+// 交换两个元素, 优先使用元素类型自己的 swap (通过 ADL 查找)
+// 也接受代理迭代器解引用得到的临时代理对象 (如 ZipRef)
+template <typename T>
+inline void swap_elements(T &&lhs, T &&rhs) {
+    using std::swap;
+    swap(lhs, rhs);
+}
+
 // Binary function that accepts two elements in the range as arguments,
 // and returns a value convertible to bool.
 // The value returned indicates whether the element passed as first argument is
 // considered less than the second.
 template <typename T>
-inline bool compare_asc(const T &lhs, const T &rhs) {
+constexpr bool compare_asc(const T &lhs, const T &rhs) {
     return lhs < rhs;
 }
 template <typename T>
-inline bool compare_desc(const T &lhs, const T &rhs) {
+constexpr bool compare_desc(const T &lhs, const T &rhs) {
     return lhs > rhs;
 }
 // ==
-template <typename T, typename TComparer>
-inline bool eq(const T &lhs, const T &rhs, TComparer comp) {
+template <typename T, typename U, typename TComparer>
+inline bool eq(const T &lhs, const U &rhs, TComparer comp) {
     return !comp(lhs, rhs) && !comp(rhs, lhs);
 }
 // !=
-template <typename T, typename TComparer>
-inline bool ne(const T &lhs, const T &rhs, TComparer comp) {
+template <typename T, typename U, typename TComparer>
+inline bool ne(const T &lhs, const U &rhs, TComparer comp) {
     return comp(lhs, rhs) || comp(rhs, lhs);
 }
 // <
-template <typename T, typename TComparer>
-inline bool lt(const T &lhs, const T &rhs, TComparer comp) {
+template <typename T, typename U, typename TComparer>
+inline bool lt(const T &lhs, const U &rhs, TComparer comp) {
     return comp(lhs, rhs);
 }
 // >
-template <typename T, typename TComparer>
-inline bool gt(const T &lhs, const T &rhs, TComparer comp) {
+template <typename T, typename U, typename TComparer>
+inline bool gt(const T &lhs, const U &rhs, TComparer comp) {
     return comp(rhs, lhs);
 }
 // <=
-template <typename T, typename TComparer>
-inline bool le(const T &lhs, const T &rhs, TComparer comp) {
+template <typename T, typename U, typename TComparer>
+inline bool le(const T &lhs, const U &rhs, TComparer comp) {
     return !comp(rhs, lhs);
 }
 // >=
-template <typename T, typename TComparer>
-inline bool ge(const T &lhs, const T &rhs, TComparer comp) {
+template <typename T, typename U, typename TComparer>
+inline bool ge(const T &lhs, const U &rhs, TComparer comp) {
     return !comp(lhs, rhs);
 }
 
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
 
 #include "memory.hpp"
 #include "resizing_array.hpp"
@@ -30,11 +34,8 @@ public:
 public:
     template <typename... TArgs>
     iterator emplace(const_iterator pos, TArgs &&... args) {
-        iterator ne = std::next(this->end());
-        iterator mp = make_iter(pos);
-        this->ensure_capacity_enough(this->size() + 1);
-        uninit_move_backward_using_alloc(this->alloc(), mp, this->end(), ne);
-        this->construct(make_iter(pos), std::forward<TArgs>(args)...);
+        iterator mp = open_gap(pos, 1);
+        this->construct(mp, std::forward<TArgs>(args)...);
         this->set_size(this->size() + 1);
         return mp;
     }
@@ -46,14 +47,10 @@ public:
     }
 
     iterator insert(const_iterator pos, size_type count, const_reference val) {
-        size_type ns = this->size() + count;
-        iterator ne = this->end() + count;
-        iterator mp = make_iter(pos);
-        this->ensure_capacity_enough(this->size() + count);
-        uninit_move_backward_using_alloc(this->alloc(), mp, this->end(), ne);
+        iterator mp = open_gap(pos, count);
         uninit_fill_n_using_alloc(this->alloc(), mp, count, val);
-        this->set_size(ns);
-        return make_iter(pos);
+        this->set_size(this->size() + count);
+        return mp;
     }
 
     template <typename InputIt>
@@ -61,25 +58,26 @@ public:
         static_assert(std::is_base_of_v<std::input_iterator_tag,
                                         typename std::iterator_traits<InputIt>::iterator_category>,
                       "InputIt must be an input iterator.");
-        auto distance = std::distance(first, last);
-        size_type ns = this->size() + distance;
-        iterator ne = this->end() + distance;
-        iterator mp = make_iter(pos);
-        this->ensure_capacity_enough(ns);
-        uninit_move_backward_using_alloc(this->alloc(), mp, this->end(), ne);
-        uninit_copy_using_alloc(this->alloc(), first, last, mp);
-        this->set_size(ns);
-        return mp;
+        if constexpr (is_forward_iterator<InputIt>) {
+            size_type count = std::distance(first, last);
+            iterator mp = open_gap(pos, count);
+            uninit_copy_using_alloc(this->alloc(), first, last, mp);
+            this->set_size(this->size() + count);
+            return mp;
+        } else {
+            // 输入迭代器只能遍历一次, 先追加到末尾再旋转到 pos
+            difference_type off = pos - this->cbegin();
+            size_type old_size = this->size();
+            for (; first != last; ++first) this->emplace_back(*first);
+            std::rotate(this->begin() + off, this->begin() + old_size, this->end());
+            return this->begin() + off;
+        }
     }
 
     iterator insert(const_iterator pos, std::initializer_list<value_type> vals) {
-        size_type ns = this->size() + vals.size();
-        iterator ne = this->end() + vals.size();
-        iterator mp = make_iter(pos);
-        this->ensure_capacity_enough(ns);
-        uninit_move_backward_using_alloc(this->alloc(), mp, this->end(), ne);
+        iterator mp = open_gap(pos, vals.size());
         uninit_copy_using_alloc(this->alloc(), vals.begin(), vals.end(), mp);
-        this->set_size(ns);
+        this->set_size(this->size() + vals.size());
         return mp;
     }
 
@@ -99,8 +97,92 @@ public:
         return mf;
     }
 
+    // 一次遍历删除所有满足 pred 的元素, 每个保留的元素最多移动一次, 返回删除的个数
+    template <typename Pred>
+    size_type erase_if(Pred pred) {
+        iterator last = this->end();
+        iterator out = std::find_if(this->begin(), last, pred);
+        if (out == last) return 0;
+        for (iterator i = std::next(out); i != last; ++i) {
+            if (!pred(*i)) *out++ = std::move(*i);
+        }
+        size_type removed = last - out;
+        destroy_using_alloc(this->alloc(), out, last);
+        this->set_size(this->size() - removed);
+        return removed;
+    }
+    // 删除所有等于 val 的元素, 返回删除的个数
+    size_type remove(const_reference val) {
+        return erase_if([&val](const_reference x) { return x == val; });
+    }
+
+    // 追加 range 中的所有元素, 前向迭代器的范围最多扩容一次
+    template <typename Range>
+    void append_range(Range &&range) {
+        auto first = std::begin(range);
+        auto last = std::end(range);
+        if constexpr (is_forward_iterator<decltype(first)>) {
+            size_type count = std::distance(first, last);
+            this->ensure_capacity_enough(this->size() + count);
+            uninit_copy_using_alloc(this->alloc(), first, last, this->end());
+            this->set_size(this->size() + count);
+        } else {
+            for (; first != last; ++first) this->emplace_back(*first);
+        }
+    }
+
+    // 一次插入多个元素: 第 k 个值插入到原下标 positions[k] 的元素之前 (等于 size() 时追加到末尾)
+    // positions 必须非递减, 相同位置的值按给出的顺序排列; 两个迭代器都至少是双向迭代器
+    // 每个原有元素最多移动一次
+    template <typename PosIt, typename BidIt>
+    void insert_at(PosIt pos_first, PosIt pos_last, BidIt val_first) {
+        size_type n = this->size(), count = 0, prev = 0;
+        for (PosIt p = pos_first; p != pos_last; ++p, ++count) {
+            size_type idx = *p;
+            if (idx > n) throw std::out_of_range("Index out of range.");
+            if (idx < prev) throw std::invalid_argument("Positions must be sorted.");
+            prev = idx;
+        }
+        if (count == 0) return;
+        this->ensure_capacity_enough(n + count);
+
+        // 从后往前填: dst 之后已经就位, src 之前的原元素还没有移动
+        pointer base = this->data();
+        size_type dst = n + count, src = n;
+        BidIt val = std::next(val_first, count);
+        auto put = [this, base, n](size_type i, auto &&x) {
+            if (i >= n)
+                this->construct(base + i, std::forward<decltype(x)>(x));
+            else
+                base[i] = std::forward<decltype(x)>(x);
+        };
+        std::reverse_iterator<PosIt> p(pos_last), pend(pos_first);
+        for (; p != pend; ++p) {
+            size_type idx = *p;
+            while (src > idx) {
+                --src;
+                put(--dst, std::move(base[src]));
+            }
+            put(--dst, *--val);
+        }
+        this->set_size(n + count);
+    }
+
 private:
+    template <typename It>
+    static constexpr bool is_forward_iterator =
+        std::is_base_of_v<std::forward_iterator_tag,
+                          typename std::iterator_traits<It>::iterator_category>;
+
     iterator make_iter(const_iterator iter) { return this->data() + (iter - this->data()); }
+    // 在 pos 处空出 count 个位置, 扩容之后才计算迭代器, 避免扩容使 pos 失效
+    iterator open_gap(const_iterator pos, size_type count) {
+        difference_type off = pos - this->cbegin();
+        this->ensure_capacity_enough(this->size() + count);
+        iterator mp = this->begin() + off;
+        uninit_move_backward_using_alloc(this->alloc(), mp, this->end(), this->end() + count);
+        return mp;
+    }
 };
 
 }  // namespace alg
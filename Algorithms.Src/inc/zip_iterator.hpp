@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "utility.hpp"
+
+namespace alg {
+
+// 把几个等长的列 (struct-of-arrays) 拼成一个序列, 排序时各列同步移动, 不需要先拼成结构体数组
+
+// ZipIterator 的引用类型: 保存各列元素的引用, 赋值和交换都作用于各列中的元素本身
+// Refs 是左值引用时, 转换为 value_type (std::tuple) 和赋值都复制各列的值;
+// iter_move 得到的 ZipRef 保存右值引用, 转换和赋值都移动各列的值
+template <typename... Refs>
+class ZipRef {
+    template <typename...>
+    friend class ZipRef;
+
+public:
+    using value_type = std::tuple<std::remove_cv_t<std::remove_reference_t<Refs>>...>;
+
+public:
+    explicit ZipRef(Refs... refs) : _refs(std::forward<Refs>(refs)...) {}
+    ZipRef(const ZipRef &rhs) = default;
+
+    ZipRef &operator=(const ZipRef &rhs) {
+        assign(rhs._refs, std::index_sequence_for<Refs...>());
+        return *this;
+    }
+    template <typename... Rs, typename = std::enable_if_t<sizeof...(Rs) == sizeof...(Refs)>>
+    ZipRef &operator=(const ZipRef<Rs...> &rhs) {
+        forward_assign<Rs...>(rhs._refs, std::index_sequence_for<Refs...>());
+        return *this;
+    }
+    ZipRef &operator=(const value_type &rhs) {
+        assign(rhs, std::index_sequence_for<Refs...>());
+        return *this;
+    }
+    ZipRef &operator=(value_type &&rhs) {
+        move_assign(rhs, std::index_sequence_for<Refs...>());
+        return *this;
+    }
+    operator value_type() const { return values(std::index_sequence_for<Refs...>()); }
+
+    template <size_t I>
+    decltype(auto) get() const noexcept {
+        return std::get<I>(_refs);
+    }
+
+    // 交换两个代理所引用的元素, 而不是代理本身
+    friend void swap(ZipRef lhs, ZipRef rhs) {
+        lhs.swap_with(rhs, std::index_sequence_for<Refs...>());
+    }
+
+private:
+    template <typename Tuple, size_t... Is>
+    void assign(const Tuple &rhs, std::index_sequence<Is...>) {
+        ((std::get<Is>(_refs) = std::get<Is>(rhs)), ...);
+    }
+    template <size_t... Is>
+    void move_assign(value_type &rhs, std::index_sequence<Is...>) {
+        ((std::get<Is>(_refs) = std::move(std::get<Is>(rhs))), ...);
+    }
+    template <typename... Rs, typename Tuple, size_t... Is>
+    void forward_assign(const Tuple &rhs, std::index_sequence<Is...>) {
+        ((std::get<Is>(_refs) = std::forward<Rs>(std::get<Is>(rhs))), ...);
+    }
+    template <size_t... Is>
+    value_type values(std::index_sequence<Is...>) const {
+        return value_type(std::forward<Refs>(std::get<Is>(_refs))...);
+    }
+    template <size_t... Is>
+    void swap_with(ZipRef &rhs, std::index_sequence<Is...>) {
+        using std::swap;
+        (swap(std::get<Is>(_refs), std::get<Is>(rhs._refs)), ...);
+    }
+
+private:
+    std::tuple<Refs...> _refs;
+};
+
+// 同时移动的一组随机访问迭代器, 解引用得到 ZipRef
+template <typename... Its>
+class ZipIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using reference = ZipRef<typename std::iterator_traits<Its>::reference...>;
+    using rvalue_reference = ZipRef<decltype(iter_move(std::declval<const Its &>()))...>;
+    using value_type = typename reference::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+
+public:
+    ZipIterator() = default;
+    explicit ZipIterator(Its... its) : _its(its...) {}
+
+public:
+    reference operator*() const { return deref(std::index_sequence_for<Its...>()); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+    // 排序等算法通过 iter_move 把元素移出序列, 各列的元素都被移动而不是复制
+    friend rvalue_reference iter_move(const ZipIterator &it) {
+        return it.move_deref(std::index_sequence_for<Its...>());
+    }
+
+    ZipIterator &operator+=(difference_type n) {
+        std::apply([n](auto &... it) { ((it += n), ...); }, _its);
+        return *this;
+    }
+    ZipIterator &operator-=(difference_type n) { return *this += -n; }
+    ZipIterator &operator++() { return *this += 1; }
+    ZipIterator &operator--() { return *this += -1; }
+    ZipIterator operator++(int) {
+        ZipIterator old = *this;
+        ++*this;
+        return old;
+    }
+    ZipIterator operator--(int) {
+        ZipIterator old = *this;
+        --*this;
+        return old;
+    }
+    friend ZipIterator operator+(ZipIterator it, difference_type n) { return it += n; }
+    friend ZipIterator operator+(difference_type n, ZipIterator it) { return it += n; }
+    friend ZipIterator operator-(ZipIterator it, difference_type n) { return it -= n; }
+    // 各列步调一致, 比较第一列即可
+    friend difference_type operator-(const ZipIterator &lhs, const ZipIterator &rhs) {
+        return std::get<0>(lhs._its) - std::get<0>(rhs._its);
+    }
+    friend bool operator==(const ZipIterator &lhs, const ZipIterator &rhs) {
+        return std::get<0>(lhs._its) == std::get<0>(rhs._its);
+    }
+    friend bool operator!=(const ZipIterator &lhs, const ZipIterator &rhs) { return !(lhs == rhs); }
+    friend bool operator<(const ZipIterator &lhs, const ZipIterator &rhs) {
+        return std::get<0>(lhs._its) < std::get<0>(rhs._its);
+    }
+    friend bool operator>(const ZipIterator &lhs, const ZipIterator &rhs) { return rhs < lhs; }
+    friend bool operator<=(const ZipIterator &lhs, const ZipIterator &rhs) { return !(rhs < lhs); }
+    friend bool operator>=(const ZipIterator &lhs, const ZipIterator &rhs) { return !(lhs < rhs); }
+
+private:
+    template <size_t... Is>
+    reference deref(std::index_sequence<Is...>) const {
+        return reference(*std::get<Is>(_its)...);
+    }
+    template <size_t... Is>
+    rvalue_reference move_deref(std::index_sequence<Is...>) const {
+        return rvalue_reference(iter_move(std::get<Is>(_its))...);
+    }
+
+private:
+    std::tuple<Its...> _its;
+};
+
+template <typename... Its>
+inline ZipIterator<Its...> make_zip_iterator(Its... its) {
+    return ZipIterator<Its...>(its...);
+}
+
+// 取第 I 列, 对 ZipRef 和 std::tuple 都适用
+template <size_t I, typename... Refs>
+inline decltype(auto) zip_get(const ZipRef<Refs...> &ref) noexcept {
+    return ref.template get<I>();
+}
+template <size_t I, typename... Ts>
+inline const auto &zip_get(const std::tuple<Ts...> &value) noexcept {
+    return std::get<I>(value);
+}
+
+// 只按第 I 列比较, 参数可以是 ZipRef 或取出的 value_type, 比较时不复制元素
+template <size_t I, typename TComparer = std::less<>>
+class ColumnComparer {
+public:
+    explicit ColumnComparer(TComparer comp = TComparer()) : _comp(comp) {}
+
+    template <typename L, typename R>
+    bool operator()(const L &lhs, const R &rhs) const {
+        return _comp(zip_get<I>(lhs), zip_get<I>(rhs));
+    }
+
+private:
+    TComparer _comp;
+};
+
+template <size_t I, typename TComparer = std::less<>>
+inline ColumnComparer<I, TComparer> by_column(TComparer comp = TComparer()) {
+    return ColumnComparer<I, TComparer>(comp);
+}
+
+}  // namespace alg
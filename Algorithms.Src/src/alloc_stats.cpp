@@ -0,0 +1,88 @@
+#include "alloc_stats.hpp"
+
+#include <map>
+#include <mutex>
+
+namespace alg {
+
+namespace {
+
+using size_type = AllocStats::size_type;
+
+size_type bucket_of(size_type bytes) noexcept {
+    size_type k = 0;
+    while (bytes >>= 1) ++k;
+    return k < AllocStats::BUCKETS ? k : AllocStats::BUCKETS - 1;
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<AllocStats>, std::less<>> stats;
+};
+
+// 不析构, 静态对象析构期间的释放仍然可以记录
+Registry &registry() {
+    static Registry *r = new Registry;
+    return *r;
+}
+
+}  // namespace
+
+AllocStats &AllocStats::for_tag(std::string_view tag) {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto iter = r.stats.find(tag);
+    if (iter == r.stats.end()) {
+        iter = r.stats.emplace(std::string(tag), std::make_unique<AllocStats>(std::string(tag))).first;
+    }
+    return *iter->second;
+}
+
+std::vector<AllocStats::Snapshot> AllocStats::all() {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::vector<Snapshot> result;
+    result.reserve(r.stats.size());
+    for (auto &kv : r.stats) result.push_back(kv.second->snapshot());
+    return result;
+}
+
+void AllocStats::record_allocate(size_type bytes) noexcept {
+    _allocations.fetch_add(1, std::memory_order_relaxed);
+    _bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+    _histogram[bucket_of(bytes)].fetch_add(1, std::memory_order_relaxed);
+    size_type live = _live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_type peak = _peak_live_bytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !_peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void AllocStats::record_deallocate(size_type bytes) noexcept {
+    _deallocations.fetch_add(1, std::memory_order_relaxed);
+    _live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+AllocStats::Snapshot AllocStats::snapshot() const {
+    Snapshot s;
+    s.tag = _tag;
+    s.allocations = _allocations.load(std::memory_order_relaxed);
+    s.deallocations = _deallocations.load(std::memory_order_relaxed);
+    s.bytes_allocated = _bytes_allocated.load(std::memory_order_relaxed);
+    s.live_bytes = _live_bytes.load(std::memory_order_relaxed);
+    s.peak_live_bytes = _peak_live_bytes.load(std::memory_order_relaxed);
+    for (size_type k = 0; k != BUCKETS; ++k) {
+        s.histogram[k] = _histogram[k].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void AllocStats::reset() noexcept {
+    _allocations.store(0, std::memory_order_relaxed);
+    _deallocations.store(0, std::memory_order_relaxed);
+    _bytes_allocated.store(0, std::memory_order_relaxed);
+    _peak_live_bytes.store(_live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    for (auto &count : _histogram) count.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace alg
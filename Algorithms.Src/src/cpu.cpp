@@ -0,0 +1,68 @@
+#include "cpu.hpp"
+
+#if defined(ALG_X86) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace alg::cpu {
+
+#if defined(ALG_X86) && defined(_MSC_VER)
+namespace {
+
+struct Features {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool avx2 = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+
+    Features() {
+        int regs[4];
+        __cpuid(regs, 0);
+        int max_leaf = regs[0];
+        __cpuid(regs, 1);
+        sse2 = (regs[3] >> 26) & 1;
+        ssse3 = (regs[2] >> 9) & 1;
+        bool osxsave = (regs[2] >> 27) & 1;
+        if (!osxsave || max_leaf < 7) return;
+        // 操作系统需要保存 YMM (以及 ZMM) 寄存器状态
+        unsigned long long xcr0 = _xgetbv(0);
+        bool ymm = (xcr0 & 0x6) == 0x6;
+        bool zmm = (xcr0 & 0xE6) == 0xE6;
+        __cpuidex(regs, 7, 0);
+        avx2 = ymm && ((regs[1] >> 5) & 1);
+        avx512f = zmm && ((regs[1] >> 16) & 1);
+        avx512bw = avx512f && ((regs[1] >> 30) & 1);
+    }
+};
+
+const Features &features() {
+    static const Features f;
+    return f;
+}
+
+}  // namespace
+
+bool has_sse2() noexcept { return features().sse2; }
+bool has_ssse3() noexcept { return features().ssse3; }
+bool has_avx2() noexcept { return features().avx2; }
+bool has_avx512f() noexcept { return features().avx512f; }
+bool has_avx512bw() noexcept { return features().avx512bw; }
+#elif defined(ALG_X86)
+bool has_sse2() noexcept { return __builtin_cpu_supports("sse2"); }
+bool has_ssse3() noexcept { return __builtin_cpu_supports("ssse3"); }
+bool has_avx2() noexcept { return __builtin_cpu_supports("avx2"); }
+bool has_avx512f() noexcept { return __builtin_cpu_supports("avx512f"); }
+bool has_avx512bw() noexcept {
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+}
+#else
+bool has_sse2() noexcept { return false; }
+bool has_ssse3() noexcept { return false; }
+bool has_avx2() noexcept { return false; }
+bool has_avx512f() noexcept { return false; }
+bool has_avx512bw() noexcept { return false; }
+#endif
+
+}  // namespace alg::cpu
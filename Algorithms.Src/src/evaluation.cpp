@@ -1,47 +1,241 @@
 #include "evaluation.hpp"
 
+#include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <functional>
 #include <sstream>
+#include <stdexcept>
 
+#include "cpu.hpp"
 #include "stack.hpp"
 
+#if defined(ALG_X86)
+#include <immintrin.h>
+#endif
+
 namespace alg {
 
-double evaluate(const std::string &expr) {
+namespace {
+
+// 每个操作符一次处理一块数据, 中间结果留在缓存里
+constexpr size_t BLOCK = 256;
+
+// 一组按块计算的内核, 运行时按 CPU 支持的指令集选择一组
+struct BlockKernels {
+    void (*fill)(double *dst, double v, size_t n);
+    void (*add)(double *dst, const double *a, const double *b, size_t n);
+    void (*sub)(double *dst, const double *a, const double *b, size_t n);
+    void (*mul)(double *dst, const double *a, const double *b, size_t n);
+    void (*div)(double *dst, const double *a, const double *b, size_t n);
+    void (*sqrt)(double *dst, const double *a, size_t n);
+};
+
+// 生成一个指令集的全部内核: 先按向量宽度处理, 尾部不足一个向量的元素逐个计算
+// 内在函数必须内联进带有相同 target 的函数, 所以每个指令集各写一遍, 而不是共用模板
+#define ALG_BLOCK_BINARY(name, isa, lanes, load, store, vop, op)             \
+    ALG_TARGET(isa)                                                          \
+    void name(double *dst, const double *a, const double *b, size_t n) {     \
+        size_t i = 0;                                                        \
+        for (; i + lanes <= n; i += lanes)                                   \
+            store(dst + i, vop(load(a + i), load(b + i)));                   \
+        for (; i != n; ++i) dst[i] = a[i] op b[i];                           \
+    }
+#define ALG_BLOCK_KERNELS(prefix, isa, lanes, load, store, set1, vadd, vsub, vmul, vdiv, vsqrt) \
+    ALG_TARGET(isa)                                                          \
+    void prefix##_fill(double *dst, double v, size_t n) {                    \
+        size_t i = 0;                                                        \
+        auto vv = set1(v);                                                   \
+        for (; i + lanes <= n; i += lanes) store(dst + i, vv);               \
+        for (; i != n; ++i) dst[i] = v;                                      \
+    }                                                                        \
+    ALG_BLOCK_BINARY(prefix##_add, isa, lanes, load, store, vadd, +)         \
+    ALG_BLOCK_BINARY(prefix##_sub, isa, lanes, load, store, vsub, -)         \
+    ALG_BLOCK_BINARY(prefix##_mul, isa, lanes, load, store, vmul, *)         \
+    ALG_BLOCK_BINARY(prefix##_div, isa, lanes, load, store, vdiv, /)         \
+    ALG_TARGET(isa)                                                          \
+    void prefix##_sqrt(double *dst, const double *a, size_t n) {             \
+        size_t i = 0;                                                        \
+        for (; i + lanes <= n; i += lanes) store(dst + i, vsqrt(load(a + i))); \
+        for (; i != n; ++i) dst[i] = std::sqrt(a[i]);                        \
+    }                                                                        \
+    const BlockKernels prefix##_kernels = {prefix##_fill, prefix##_add, prefix##_sub, \
+                                           prefix##_mul,  prefix##_div, prefix##_sqrt};
+
+void scalar_fill(double *dst, double v, size_t n) { std::fill_n(dst, n, v); }
+template <typename Op>
+void scalar_binary(double *dst, const double *a, const double *b, size_t n) {
+    for (size_t i = 0; i != n; ++i) dst[i] = Op()(a[i], b[i]);
+}
+void scalar_sqrt(double *dst, const double *a, size_t n) {
+    for (size_t i = 0; i != n; ++i) dst[i] = std::sqrt(a[i]);
+}
+const BlockKernels scalar_kernels = {scalar_fill,
+                                     scalar_binary<std::plus<double>>,
+                                     scalar_binary<std::minus<double>>,
+                                     scalar_binary<std::multiplies<double>>,
+                                     scalar_binary<std::divides<double>>,
+                                     scalar_sqrt};
+
+#if defined(ALG_X86)
+ALG_BLOCK_KERNELS(sse2, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_add_pd,
+                  _mm_sub_pd, _mm_mul_pd, _mm_div_pd, _mm_sqrt_pd)
+ALG_BLOCK_KERNELS(avx2, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd,
+                  _mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd, _mm256_div_pd, _mm256_sqrt_pd)
+ALG_BLOCK_KERNELS(avx512, "avx512f", 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd,
+                  _mm512_add_pd, _mm512_sub_pd, _mm512_mul_pd, _mm512_div_pd, _mm512_sqrt_pd)
+#endif
+
+#undef ALG_BLOCK_KERNELS
+#undef ALG_BLOCK_BINARY
+
+// 没有 SSE2 的平台 (以及非 x86) 用标量版本
+const BlockKernels &select_block_kernels() {
+#if defined(ALG_X86)
+    if (cpu::has_avx512f()) return avx512_kernels;
+    if (cpu::has_avx2()) return avx2_kernels;
+    if (cpu::has_sse2()) return sse2_kernels;
+#endif
+    return scalar_kernels;
+}
+
+bool is_identifier(const std::string &token) {
+    unsigned char c = token[0];
+    return std::isalpha(c) || c == '_';
+}
+
+}  // namespace
+
+Expression::Expression(const std::string &expr) {
     std::istringstream t_stream(expr);
-    Stack<std::string> ops;
-    Stack<double> vals;
-    auto is_operator = [](const std::string &token) {
-        return token == "+" || token == "-" || token == "*" || token == "/" ||
-               token == "sqrt";
+    Stack<OpCode> ops;
+    size_t depth = 0;
+    auto emit = [this, &depth](OpCode op, size_t index) {
+        if (op == OpCode::Const || op == OpCode::Var) {
+            ++depth;
+        } else if (op != OpCode::Sqrt) {
+            if (depth < 2) throw std::invalid_argument("Malformed expression.");
+            --depth;
+        } else if (depth < 1) {
+            throw std::invalid_argument("Malformed expression.");
+        }
+        _max_depth = std::max(_max_depth, depth);
+        _code.push_back({op, index});
     };
 
     std::string token;
     while (t_stream >> token) {
         if (token == "(") {
             continue;
-        } else if (is_operator(token)) {
-            ops.push(token);
+        } else if (token == "+") {
+            ops.push(OpCode::Add);
+        } else if (token == "-") {
+            ops.push(OpCode::Sub);
+        } else if (token == "*") {
+            ops.push(OpCode::Mul);
+        } else if (token == "/") {
+            ops.push(OpCode::Div);
+        } else if (token == "sqrt") {
+            ops.push(OpCode::Sqrt);
         } else if (token == ")") {
-            std::string op = ops.pop();
-            double v = vals.pop();
-            if (op == "+") {
-                v = vals.pop() + v;
-            } else if (op == "-") {
-                v = vals.pop() - v;
-            } else if (op == "*") {
-                v = vals.pop() * v;
-            } else if (op == "/") {
-                v = vals.pop() / v;
-            } else if (op == "sqrt") {
-                v = std::sqrt(v);
-            }
-            vals.push(v);
+            if (ops.empty()) throw std::invalid_argument("Malformed expression.");
+            emit(ops.pop(), 0);
+        } else if (is_identifier(token)) {
+            auto iter = std::find(_vars.begin(), _vars.end(), token);
+            if (iter == _vars.end()) iter = _vars.insert(_vars.end(), token);
+            emit(OpCode::Var, iter - _vars.begin());
         } else {
-            vals.push(std::stod(token));
+            _consts.push_back(std::stod(token));
+            emit(OpCode::Const, _consts.size() - 1);
+        }
+    }
+    if (depth != 1 || !ops.empty()) throw std::invalid_argument("Malformed expression.");
+}
+
+double Expression::evaluate(const double *vals) const {
+    if (!vals && !_vars.empty()) throw std::invalid_argument("Unbound variable: " + _vars[0]);
+    Stack<double> stack;
+    for (const Instruction &ins : _code) {
+        if (ins.op == OpCode::Const) {
+            stack.push(_consts[ins.index]);
+            continue;
+        } else if (ins.op == OpCode::Var) {
+            stack.push(vals[ins.index]);
+            continue;
+        }
+        double v = stack.pop();
+        if (ins.op == OpCode::Add) {
+            v = stack.pop() + v;
+        } else if (ins.op == OpCode::Sub) {
+            v = stack.pop() - v;
+        } else if (ins.op == OpCode::Mul) {
+            v = stack.pop() * v;
+        } else if (ins.op == OpCode::Div) {
+            v = stack.pop() / v;
+        } else if (ins.op == OpCode::Sqrt) {
+            v = std::sqrt(v);
         }
+        stack.push(v);
     }
-    return vals.pop();
+    return stack.pop();
+}
+
+void Expression::evaluate(const double *const *columns, size_t n, double *out) const {
+    if (!columns && !_vars.empty()) throw std::invalid_argument("Unbound variable: " + _vars[0]);
+    // slots[d] 指向栈中第 d 个值的当前块: 变量直接指向输入列, 其余指向 bufs 中第 d 块
+    static const BlockKernels &kernels = select_block_kernels();
+    std::vector<double> bufs(_max_depth * BLOCK);
+    std::vector<const double *> slots(_max_depth);
+    for (size_t offset = 0; offset < n; offset += BLOCK) {
+        size_t len = std::min(BLOCK, n - offset);
+        size_t depth = 0;
+        for (size_t pc = 0; pc != _code.size(); ++pc) {
+            const Instruction &ins = _code[pc];
+            // 最后一条指令直接写入输出列
+            double *dst = pc + 1 == _code.size() ? out + offset : nullptr;
+            switch (ins.op) {
+                case OpCode::Const:
+                    if (!dst) dst = &bufs[depth * BLOCK];
+                    kernels.fill(dst, _consts[ins.index], len);
+                    slots[depth++] = dst;
+                    break;
+                case OpCode::Var:
+                    if (dst) {
+                        std::copy_n(columns[ins.index] + offset, len, dst);
+                    } else {
+                        slots[depth] = columns[ins.index] + offset;
+                    }
+                    ++depth;
+                    break;
+                case OpCode::Sqrt:
+                    if (!dst) dst = &bufs[(depth - 1) * BLOCK];
+                    kernels.sqrt(dst, slots[depth - 1], len);
+                    slots[depth - 1] = dst;
+                    break;
+                default: {
+                    const double *a = slots[depth - 2], *b = slots[depth - 1];
+                    if (!dst) dst = &bufs[(depth - 2) * BLOCK];
+                    if (ins.op == OpCode::Add) {
+                        kernels.add(dst, a, b, len);
+                    } else if (ins.op == OpCode::Sub) {
+                        kernels.sub(dst, a, b, len);
+                    } else if (ins.op == OpCode::Mul) {
+                        kernels.mul(dst, a, b, len);
+                    } else {
+                        kernels.div(dst, a, b, len);
+                    }
+                    slots[--depth - 1] = dst;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+double evaluate(const std::string &expr) {
+    Expression e(expr);
+    if (!e.variables().empty()) throw std::invalid_argument("Unbound variable: " + e.variables()[0]);
+    return e.evaluate();
 }
 
 }  // namespace alg
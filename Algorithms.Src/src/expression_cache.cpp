@@ -0,0 +1,73 @@
+#include "expression_cache.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+namespace alg {
+
+ExpressionCache::ExpressionCache(size_type capacity, size_type shards) : _capacity(capacity) {
+    if (capacity == 0 || shards == 0) {
+        throw std::invalid_argument("Capacity and shard count must be positive.");
+    }
+    if (shards > capacity) shards = capacity;
+    _shards.reserve(shards);
+    for (size_type i = 0; i != shards; ++i) {
+        _shards.push_back(std::make_unique<Shard>());
+        _shards.back()->capacity = capacity / shards + (i < capacity % shards ? 1 : 0);
+    }
+}
+
+ExpressionCache::value_type ExpressionCache::get(std::string_view expr) {
+    size_t hash = std::hash<std::string_view>()(expr);
+    Shard &shard = shard_of(hash);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto iter = shard.index.find(Key{expr, hash});
+        if (iter != shard.index.end()) {
+            shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            return iter->second->expr;
+        }
+    }
+    _misses.fetch_add(1, std::memory_order_relaxed);
+
+    value_type compiled = std::make_shared<const Expression>(std::string(expr));
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // 解析期间其他线程可能已经放入了同一个表达式
+    auto iter = shard.index.find(Key{expr, hash});
+    if (iter != shard.index.end()) {
+        shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+        return iter->second->expr;
+    }
+    if (shard.lru.size() == shard.capacity) {
+        const Entry &victim = shard.lru.back();
+        shard.index.erase(Key{victim.text, victim.hash});
+        shard.lru.pop_back();
+    }
+    shard.lru.push_front(Entry{std::string(expr), hash, compiled});
+    shard.index.emplace(Key{shard.lru.front().text, hash}, shard.lru.begin());
+    return compiled;
+}
+
+double ExpressionCache::evaluate(std::string_view expr, const double *vals) {
+    return get(expr)->evaluate(vals);
+}
+
+void ExpressionCache::clear() {
+    for (auto &shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->lru.clear();
+    }
+}
+
+ExpressionCache::size_type ExpressionCache::size() const {
+    size_type n = 0;
+    for (auto &shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        n += shard->lru.size();
+    }
+    return n;
+}
+
+}  // namespace alg
@@ -0,0 +1,77 @@
+#include "huge_page_allocator.hpp"
+
+#include <cstdint>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace alg::huge_pages {
+
+namespace {
+
+size_t round_up(size_t bytes) { return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE; }
+
+}  // namespace
+
+#if defined(_WIN32)
+
+void *allocate(size_t bytes) {
+    if (bytes < HUGE_PAGE_SIZE) return ::operator new(bytes);
+    size_t size = round_up(bytes);
+    // 大页要求以 GetLargePageMinimum 为单位, 且需要权限, 不满足时使用普通页
+    size_t large = GetLargePageMinimum();
+    if (large != 0 && size % large == 0) {
+        void *p = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                               PAGE_READWRITE);
+        if (p != nullptr) return p;
+    }
+    void *p = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void deallocate(void *p, size_t bytes) noexcept {
+    if (p == nullptr) return;
+    if (bytes < HUGE_PAGE_SIZE)
+        ::operator delete(p);
+    else
+        VirtualFree(p, 0, MEM_RELEASE);
+}
+
+#else
+
+void *allocate(size_t bytes) {
+    if (bytes < HUGE_PAGE_SIZE) return ::operator new(bytes);
+    size_t size = round_up(bytes);
+    // mmap 只保证按普通页对齐: 多映射一个大页, 再把首尾多余的部分还回去
+    void *raw = mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) throw std::bad_alloc();
+    uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = (begin + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    if (aligned != begin) munmap(raw, aligned - begin);
+    size_t tail = begin + size + HUGE_PAGE_SIZE - (aligned + size);
+    if (tail != 0) munmap(reinterpret_cast<void *>(aligned + size), tail);
+    void *p = reinterpret_cast<void *>(aligned);
+#if defined(MADV_HUGEPAGE)
+    madvise(p, size, MADV_HUGEPAGE);
+#endif
+    return p;
+}
+
+void deallocate(void *p, size_t bytes) noexcept {
+    if (p == nullptr) return;
+    if (bytes < HUGE_PAGE_SIZE)
+        ::operator delete(p);
+    else
+        munmap(p, round_up(bytes));
+}
+
+#endif
+
+}  // namespace alg::huge_pages
@@ -0,0 +1,98 @@
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace alg {
+
+namespace {
+
+[[noreturn]] void fail(const std::string &path) {
+    throw std::runtime_error("Cannot map file: " + path + ".");
+}
+
+}  // namespace
+
+#if defined(_WIN32)
+
+MappedFile MappedFile::open_private(const std::string &path) {
+    MappedFile result;
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) fail(path);
+    result._file = file;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) fail(path);
+    result._size = static_cast<size_t>(size.QuadPart);
+    if (result._size == 0) fail(path);
+    // PAGE_WRITECOPY + FILE_MAP_COPY 即写时复制
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapping == nullptr) fail(path);
+    result._mapping = mapping;
+    void *data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (data == nullptr) fail(path);
+    result._data = static_cast<char *>(data);
+    return result;
+}
+
+void MappedFile::close() noexcept {
+    if (_data != nullptr) UnmapViewOfFile(_data);
+    if (_mapping != nullptr) CloseHandle(_mapping);
+    if (_file != nullptr) CloseHandle(_file);
+    _data = nullptr;
+    _mapping = _file = nullptr;
+    _size = 0;
+}
+
+void MappedFile::swap(MappedFile &rhs) noexcept {
+    std::swap(_data, rhs._data);
+    std::swap(_size, rhs._size);
+    std::swap(_file, rhs._file);
+    std::swap(_mapping, rhs._mapping);
+}
+
+#else
+
+MappedFile MappedFile::open_private(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) fail(path);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        fail(path);
+    }
+    // MAP_PRIVATE 即写时复制; 映射建立后就不再需要文件描述符
+    void *data = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) fail(path);
+    MappedFile result;
+    result._data = static_cast<char *>(data);
+    result._size = static_cast<size_t>(st.st_size);
+    return result;
+}
+
+void MappedFile::close() noexcept {
+    if (_data != nullptr) munmap(_data, _size);
+    _data = nullptr;
+    _size = 0;
+}
+
+void MappedFile::swap(MappedFile &rhs) noexcept {
+    std::swap(_data, rhs._data);
+    std::swap(_size, rhs._size);
+}
+
+#endif
+
+}  // namespace alg
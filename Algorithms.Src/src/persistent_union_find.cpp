@@ -0,0 +1,144 @@
+#include "union_find/persistent_union_find.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace alg {
+
+namespace {
+
+constexpr char MAGIC[8] = {'A', 'L', 'G', 'U', 'N', 'I', 'O', 'N'};
+constexpr uint32_t ENDIAN_MARK = 0x01020304;
+constexpr uint64_t ALIGNMENT = 64;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;  // 按本机字节序写入, 读出来不等于 ENDIAN_MARK 说明字节序不同
+    uint32_t index_bytes;
+    uint32_t reserved;
+    uint64_t size;
+    uint64_t count;
+    uint64_t parent_offset;
+    uint64_t rank_offset;
+    uint64_t file_size;
+};
+static_assert(sizeof(Header) <= ALIGNMENT, "Header must fit in the first block.");
+
+uint64_t align_up(uint64_t n) { return (n + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+Header make_header(uint64_t size, uint64_t count) {
+    Header h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = PersistentUnionFind::VERSION;
+    h.byte_order = ENDIAN_MARK;
+    h.index_bytes = sizeof(PersistentUnionFind::index_type);
+    h.size = size;
+    h.count = count;
+    h.parent_offset = ALIGNMENT;
+    h.rank_offset = align_up(h.parent_offset + size * sizeof(PersistentUnionFind::index_type));
+    h.file_size = align_up(h.rank_offset + size);
+    return h;
+}
+
+// 在分配存储之前检查, 否则过大的 n 会先因为分配失败抛出 bad_alloc
+// 节点下标最大为 n - 1, 所以 n 可以比 index_type 的最大值大 1
+bool fits_index(uint64_t n) {
+    return n == 0 || n - 1 <= std::numeric_limits<PersistentUnionFind::index_type>::max();
+}
+
+size_t checked_size(size_t n) {
+    if (!fits_index(n)) {
+        throw std::invalid_argument("Too many nodes for the index type.");
+    }
+    return n;
+}
+
+[[noreturn]] void bad_file(const std::string &path, const char *reason) {
+    throw std::runtime_error("Invalid union-find file " + path + ": " + reason + ".");
+}
+
+}  // namespace
+
+PersistentUnionFind::PersistentUnionFind(size_t n)
+    : _size(checked_size(n)), _count(n), _heap_parent(_size), _heap_rank(_size) {
+    std::iota(_heap_parent.begin(), _heap_parent.end(), index_type(0));
+    _parent = _heap_parent.data();
+    _rank = _heap_rank.data();
+}
+
+PersistentUnionFind PersistentUnionFind::open(const std::string &path) {
+    PersistentUnionFind uf;
+    uf._file = MappedFile::open_private(path);
+    if (uf._file.size() < sizeof(Header)) bad_file(path, "file is too short");
+    Header h;
+    std::memcpy(&h, uf._file.data(), sizeof(Header));
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) bad_file(path, "bad magic");
+    if (h.byte_order != ENDIAN_MARK) bad_file(path, "byte order mismatch");
+    if (h.version != VERSION) bad_file(path, "unsupported version");
+    if (h.index_bytes != sizeof(index_type)) bad_file(path, "index width mismatch");
+    // 先检查 size 和 count, 否则计算布局时 size * sizeof(index_type) 可能溢出
+    if (!fits_index(h.size)) bad_file(path, "too many nodes");
+    if (h.count > h.size) bad_file(path, "more components than nodes");
+    Header expected = make_header(h.size, h.count);
+    if (h.parent_offset != expected.parent_offset || h.rank_offset != expected.rank_offset ||
+        h.file_size != expected.file_size || uf._file.size() < h.file_size) {
+        bad_file(path, "inconsistent layout");
+    }
+    uf._size = h.size;
+    uf._count = h.count;
+    uf._parent = reinterpret_cast<index_type *>(uf._file.data() + h.parent_offset);
+    uf._rank = reinterpret_cast<unsigned char *>(uf._file.data() + h.rank_offset);
+    return uf;
+}
+
+void PersistentUnionFind::save(const std::string &path) const {
+    Header h = make_header(_size, _count);
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Cannot write file: " + tmp_path + ".");
+        const char zeros[ALIGNMENT] = {};
+        out.write(reinterpret_cast<const char *>(&h), sizeof(Header));
+        out.write(zeros, h.parent_offset - sizeof(Header));
+        out.write(reinterpret_cast<const char *>(_parent), _size * sizeof(index_type));
+        out.write(zeros, h.rank_offset - h.parent_offset - _size * sizeof(index_type));
+        out.write(reinterpret_cast<const char *>(_rank), _size);
+        out.write(zeros, h.file_size - h.rank_offset - _size);
+        if (!out.flush()) throw std::runtime_error("Cannot write file: " + tmp_path + ".");
+    }
+    std::filesystem::rename(tmp_path, path);
+}
+
+bool PersistentUnionFind::connect(size_t n1, size_t n2) {
+    size_t r1 = find_root(n1), r2 = find_root(n2);
+    if (r1 == r2) return false;
+    if (_rank[r1] > _rank[r2]) std::swap(r1, r2);
+    _parent[r1] = static_cast<index_type>(r2);
+    if (_rank[r1] == _rank[r2]) ++_rank[r2];
+    --_count;
+    return true;
+}
+
+bool PersistentUnionFind::is_connected(size_t n1, size_t n2) const {
+    return find_root(n1) == find_root(n2);
+}
+
+size_t PersistentUnionFind::find_root(size_t i) const {
+    if (i >= _size) throw std::out_of_range("Index out of range.");
+    // 映射的文件可能已损坏, 父节点越界或成环时报错, 而不是越界读或死循环
+    for (size_t steps = 0; _parent[i] != i; ++steps) {
+        if (_parent[i] >= _size || steps == _size) {
+            throw std::runtime_error("Corrupted union-find parent array.");
+        }
+        i = _parent[i];
+    }
+    return i;
+}
+
+}  // namespace alg
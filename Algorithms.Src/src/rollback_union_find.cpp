@@ -0,0 +1,117 @@
+#include "union_find/rollback_union_find.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace alg {
+
+RollbackUnionFind::RollbackUnionFind(size_t n) : _parent(n), _rank(n), _count(n) {
+    std::iota(_parent.begin(), _parent.end(), size_t(0));
+}
+
+bool RollbackUnionFind::connect(size_t n1, size_t n2) {
+    size_t r1 = find_root(n1), r2 = find_root(n2);
+    if (r1 == r2) return false;
+    // 矮的树挂到高的树下, 树高不超过 log n
+    if (_rank[r1] > _rank[r2]) std::swap(r1, r2);
+    _parent[r1] = r2;
+    bool raised = _rank[r1] == _rank[r2];
+    if (raised) ++_rank[r2];
+    _log.push_back({r1, raised});
+    --_count;
+    return true;
+}
+
+bool RollbackUnionFind::is_connected(size_t n1, size_t n2) const {
+    return find_root(n1) == find_root(n2);
+}
+
+size_t RollbackUnionFind::find_root(size_t i) const {
+    if (i >= _parent.size()) throw std::out_of_range("Index out of range.");
+    while (_parent[i] != i) i = _parent[i];
+    return i;
+}
+
+void RollbackUnionFind::rollback(size_t to) {
+    if (to > _log.size()) throw std::invalid_argument("Snapshot is newer than the log.");
+    while (_log.size() > to) {
+        Change change = _log.back();
+        _log.pop_back();
+        size_t root = _parent[change.child];
+        if (change.rank_raised) --_rank[root];
+        _parent[change.child] = change.child;
+        ++_count;
+    }
+}
+
+namespace {
+
+struct Solver {
+    RollbackUnionFind uf;
+    std::vector<std::vector<std::pair<size_t, size_t>>> segments;  // 线段树节点上的边
+    std::vector<std::vector<size_t>> at_time;                      // 每个叶子上的询问
+    const std::vector<ConnectivityQuery> &queries;
+    std::vector<bool> answers;
+
+    Solver(size_t n, size_t leaves, const std::vector<ConnectivityQuery> &queries)
+        : uf(n), segments(4 * leaves), at_time(leaves), queries(queries),
+          answers(queries.size()) {}
+
+    void add_edge(size_t node, size_t lo, size_t hi, size_t first, size_t last,
+                  const TimedEdge &e) {
+        if (last <= lo || hi <= first) return;
+        if (first <= lo && hi <= last) {
+            segments[node].push_back({e.n1, e.n2});
+            return;
+        }
+        size_t mid = lo + (hi - lo) / 2;
+        add_edge(2 * node + 1, lo, mid, first, last, e);
+        add_edge(2 * node + 2, mid, hi, first, last, e);
+    }
+    void solve(size_t node, size_t lo, size_t hi) {
+        size_t saved = uf.snapshot();
+        for (const auto &e : segments[node]) uf.connect(e.first, e.second);
+        if (hi - lo == 1) {
+            for (size_t q : at_time[lo]) {
+                answers[q] = uf.is_connected(queries[q].n1, queries[q].n2);
+            }
+        } else {
+            size_t mid = lo + (hi - lo) / 2;
+            solve(2 * node + 1, lo, mid);
+            solve(2 * node + 2, mid, hi);
+        }
+        uf.rollback(saved);
+    }
+};
+
+}  // namespace
+
+std::vector<bool> dynamic_connectivity(size_t n, const std::vector<TimedEdge> &edges,
+                                       const std::vector<ConnectivityQuery> &queries) {
+    if (queries.empty()) return {};
+    // 只有询问的时刻需要叶子: 把询问时刻排序去重, 线段树建在它们的下标上
+    std::vector<size_t> times;
+    times.reserve(queries.size());
+    for (const auto &q : queries) times.push_back(q.time);
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+    auto leaf = [&](size_t time) {
+        return static_cast<size_t>(std::lower_bound(times.begin(), times.end(), time) -
+                                   times.begin());
+    };
+
+    Solver solver(n, times.size(), queries);
+    for (size_t i = 0; i != queries.size(); ++i) solver.at_time[leaf(queries[i].time)].push_back(i);
+    for (const auto &e : edges) {
+        if (e.n1 >= n || e.n2 >= n) throw std::out_of_range("Index out of range.");
+        // [added, removed) 内的询问时刻对应叶子 [leaf(added), leaf(removed))
+        size_t first = leaf(e.added), last = leaf(e.removed);
+        if (first < last) solver.add_edge(0, 0, times.size(), first, last, e);
+    }
+    solver.solve(0, 0, times.size());
+    return solver.answers;
+}
+
+}  // namespace alg
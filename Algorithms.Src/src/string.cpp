@@ -1,7 +1,16 @@
 #include "string.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 
+#include "cpu.hpp"
+
+#if defined(ALG_X86)
+#include <immintrin.h>
+#endif
+
 namespace alg {
 
 // BIN  HEX
@@ -14,17 +23,102 @@ namespace alg {
 // 7  U+0000~U+007F        1 0xxxxxxx
 // 11 U+0080~U+07FF        2 110xxxxx 10xxxxxx
 // 16 U+0800~U+FFFF        3 1110xxxx 10xxxxxx 10xxxxxx
-// 21 U+10000~U+1FFFFF     4 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-// 26 U+200000~U+3FFFFFF   5 111110xx 10xxxxxx 10xxxxxx 10xxxxxx 10xxxxxx
-// 31 U+4000000~U+7FFFFFFF 6 1111110x 10xxxxxx 10xxxxxx 10xxxxxx 10xxxxxx 10xxxxxx
+// 21 U+10000~U+10FFFF     4 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+// RFC 3629 起 UTF-8 只到 U+10FFFF, 原先的 5, 6 字节形式已不合法
+
+namespace {
 
-std::string::size_type utf8_walk_length(const std::string &str) {
-    std::string::size_type len = 0;
-    for (char b : str) {
-        if ((b & 0xC0) != 0x80) ++len;
+using size_type = std::string::size_type;
+
+size_type walk_length_scalar(const char *data, size_type n) {
+    size_type len = 0;
+    for (size_type i = 0; i != n; ++i) {
+        if ((data[i] & 0xC0) != 0x80) ++len;
     }
     return len;
 }
+
+#if defined(ALG_X86)
+// 非延续字节即有符号比较下 b > (int8_t)0xBF 的字节,
+// 比较结果 (0 或 -1) 逐字节累加到计数器中, 每 255 轮用 sad 横向求和一次, 避免溢出
+
+ALG_TARGET("sse2")
+size_type walk_length_sse2(const char *data, size_type n) {
+    const __m128i threshold = _mm_set1_epi8(static_cast<char>(0xBF));
+    size_type len = 0, i = 0;
+    while (n - i >= 16) {
+        __m128i counter = _mm_setzero_si128();
+        size_type rounds = std::min<size_type>((n - i) / 16, 255);
+        for (size_type r = 0; r != rounds; ++r, i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            counter = _mm_sub_epi8(counter, _mm_cmpgt_epi8(v, threshold));
+        }
+        alignas(16) std::uint64_t sums[2];
+        _mm_store_si128(reinterpret_cast<__m128i *>(sums),
+                        _mm_sad_epu8(counter, _mm_setzero_si128()));
+        len += sums[0] + sums[1];
+    }
+    return len + walk_length_scalar(data + i, n - i);
+}
+
+ALG_TARGET("avx2")
+size_type walk_length_avx2(const char *data, size_type n) {
+    const __m256i threshold = _mm256_set1_epi8(static_cast<char>(0xBF));
+    size_type len = 0, i = 0;
+    while (n - i >= 32) {
+        __m256i counter = _mm256_setzero_si256();
+        size_type rounds = std::min<size_type>((n - i) / 32, 255);
+        for (size_type r = 0; r != rounds; ++r, i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            counter = _mm256_sub_epi8(counter, _mm256_cmpgt_epi8(v, threshold));
+        }
+        alignas(32) std::uint64_t sums[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(sums),
+                           _mm256_sad_epu8(counter, _mm256_setzero_si256()));
+        len += sums[0] + sums[1] + sums[2] + sums[3];
+    }
+    return len + walk_length_scalar(data + i, n - i);
+}
+
+ALG_TARGET("avx512f,avx512bw")
+size_type walk_length_avx512(const char *data, size_type n) {
+    const __m512i threshold = _mm512_set1_epi8(static_cast<char>(0xBF));
+    const __m512i one = _mm512_set1_epi8(1);
+    size_type len = 0, i = 0;
+    while (n - i >= 64) {
+        __m512i counter = _mm512_setzero_si512();
+        size_type rounds = std::min<size_type>((n - i) / 64, 255);
+        for (size_type r = 0; r != rounds; ++r, i += 64) {
+            __m512i v = _mm512_loadu_si512(data + i);
+            __mmask64 m = _mm512_cmpgt_epi8_mask(v, threshold);
+            counter = _mm512_mask_add_epi8(counter, m, counter, one);
+        }
+        len += _mm512_reduce_add_epi64(_mm512_sad_epu8(counter, _mm512_setzero_si512()));
+    }
+    return len + walk_length_scalar(data + i, n - i);
+}
+#endif
+
+using walk_length_fn = size_type (*)(const char *, size_type);
+
+walk_length_fn select_walk_length() {
+#if defined(ALG_X86)
+    if (cpu::has_avx512bw()) return walk_length_avx512;
+    if (cpu::has_avx2()) return walk_length_avx2;
+    if (cpu::has_sse2()) return walk_length_sse2;
+#endif
+    return walk_length_scalar;
+}
+
+}  // namespace
+
+std::string::size_type utf8_walk_length(std::string_view str) {
+    return utf8_walk_length(str.data(), str.size());
+}
+std::string::size_type utf8_walk_length(const char *data, std::string::size_type n) {
+    static const walk_length_fn impl = select_walk_length();
+    return impl(data, n);
+}
 std::string utf8_char_at(const std::string &str, std::string::size_type idx) {
     using size_type = std::string::size_type;
     using const_iterator = std::string::const_iterator;
@@ -39,13 +133,12 @@ std::string utf8_char_at(const std::string &str, std::string::size_type idx) {
             current_char_size = 3;
         } else if ((*iter & 0xF8) == 0xF0) {
             current_char_size = 4;
-        } else if ((*iter & 0xFC) == 0xF8) {
-            current_char_size = 5;
-        } else if ((*iter & 0xFE) == 0xFC) {
-            current_char_size = 6;
         } else {
             throw std::invalid_argument("Not a standard UTF-8 string.");
         }
+        if (str.cend() - iter < current_char_size) {
+            throw std::invalid_argument("Not a standard UTF-8 string.");
+        }
         if (n == idx) {
             return std::string(iter, iter + current_char_size);
         }
@@ -55,4 +148,338 @@ std::string utf8_char_at(const std::string &str, std::string::size_type idx) {
     throw std::out_of_range("Index out of range.");
 }
 
+
+namespace {
+
+bool is_continuation(unsigned char b) { return (b & 0xC0) == 0x80; }
+
+// 从 pos 开始逐字节校验, 见 Unicode 标准表 3-7 (Well-Formed UTF-8 Byte Sequences)
+size_type validate_scalar(const char *data, size_type n, size_type pos) {
+    const unsigned char *s = reinterpret_cast<const unsigned char *>(data);
+    while (pos < n) {
+        unsigned char b = s[pos];
+        if (b < 0x80) {
+            ++pos;
+            continue;
+        }
+        size_type len;
+        unsigned char lo = 0x80, hi = 0xBF;  // 第二个字节的取值范围
+        if (b >= 0xC2 && b <= 0xDF) {
+            len = 2;
+        } else if (b >= 0xE0 && b <= 0xEF) {
+            len = 3;
+            if (b == 0xE0) lo = 0xA0;       // 超长编码
+            else if (b == 0xED) hi = 0x9F;  // 代理区
+        } else if (b >= 0xF0 && b <= 0xF4) {
+            len = 4;
+            if (b == 0xF0) lo = 0x90;       // 超长编码
+            else if (b == 0xF4) hi = 0x8F;  // 超过 U+10FFFF
+        } else {
+            return pos;
+        }
+        if (n - pos < len || s[pos + 1] < lo || s[pos + 1] > hi) return pos;
+        for (size_type k = 2; k != len; ++k) {
+            if (!is_continuation(s[pos + k])) return pos;
+        }
+        pos += len;
+    }
+    return std::string::npos;
+}
+
+// 向量化校验发现 i 附近有错误时, 退回到跨越 i 的序列的起始处, 由逐字节校验给出准确位置
+size_type locate_invalid(const char *data, size_type n, size_type i) {
+    size_type start = i;
+    for (size_type k = 1; k <= 3 && k <= i; ++k) {
+        if (!is_continuation(data[i - k])) {
+            start = i - k;
+            break;
+        }
+    }
+    return validate_scalar(data, n, start);
+}
+
+#if defined(ALG_X86)
+// simdjson / simdutf 的查表法 (Keiser & Lemire, "Validating UTF-8 In Less Than One
+// Instruction Per Byte"): 用前一个字节的高低半字节和当前字节的高半字节各查一次表,
+// 三个结果按位与之后不为零即为错误; 2, 3 字节后的延续字节另外用饱和减法检查
+constexpr char TOO_SHORT = 1 << 0;   // 11______ 0_______ 或 11______ 11______
+constexpr char TOO_LONG = 1 << 1;    // 0_______ 10______
+constexpr char OVERLONG_3 = 1 << 2;  // 11100000 100_____
+constexpr char TOO_LARGE = 1 << 3;   // 11110100 1001____, 11110100 101_____, 11110101~11111111
+constexpr char SURROGATE = 1 << 4;   // 11101101 101_____
+constexpr char OVERLONG_2 = 1 << 5;  // 1100000_ 10______
+constexpr char TOO_LARGE_1000 = 1 << 6;  // 11110101~11111111 1000____
+constexpr char OVERLONG_4 = 1 << 6;      // 11110000 1000____
+constexpr char TWO_CONTS = static_cast<char>(1 << 7);  // 10______ 10______
+constexpr char CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+alignas(16) constexpr char BYTE_1_HIGH[16] = {
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+};
+alignas(16) constexpr char BYTE_1_LOW[16] = {
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+};
+alignas(16) constexpr char BYTE_2_HIGH[16] = {
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+};
+// 最后三个字节分别大于这些值时, 说明有序列跨越到下一块
+alignas(16) constexpr unsigned char INCOMPLETE_MAX[16] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+ALG_TARGET("ssse3")
+size_type validate_ssse3(const char *data, size_type n) {
+    const __m128i byte_1_high = _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_1_HIGH));
+    const __m128i byte_1_low = _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_1_LOW));
+    const __m128i byte_2_high = _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_2_HIGH));
+    const __m128i incomplete_max =
+        _mm_load_si128(reinterpret_cast<const __m128i *>(INCOMPLETE_MAX));
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i prev = zero, prev_incomplete = zero;
+    size_type i = 0;
+    for (; n - i >= 16; i += 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        __m128i error = prev_incomplete;
+        if (_mm_movemask_epi8(in) != 0) {
+            __m128i prev1 = _mm_alignr_epi8(in, prev, 15);
+            __m128i sc = _mm_and_si128(
+                _mm_and_si128(
+                    _mm_shuffle_epi8(byte_1_high,
+                                     _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble)),
+                    _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, low_nibble))),
+                _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(in, 4), low_nibble)));
+            __m128i third = _mm_subs_epu8(_mm_alignr_epi8(in, prev, 14), _mm_set1_epi8(0x60));
+            __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(in, prev, 13), _mm_set1_epi8(0x70));
+            __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth),
+                                           _mm_set1_epi8(static_cast<char>(0x80)));
+            error = _mm_or_si128(error, _mm_xor_si128(must23, sc));
+            prev_incomplete = _mm_subs_epu8(in, incomplete_max);
+        } else {
+            prev_incomplete = zero;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, zero)) != 0xFFFF) {
+            return locate_invalid(data, n, i);
+        }
+        prev = in;
+    }
+    return locate_invalid(data, n, i);
+}
+
+ALG_TARGET("avx2")
+size_type validate_avx2(const char *data, size_type n) {
+    const __m256i byte_1_high = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_1_HIGH)));
+    const __m256i byte_1_low = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_1_LOW)));
+    const __m256i byte_2_high = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_2_HIGH)));
+    const __m256i incomplete_max = _mm256_inserti128_si256(
+        _mm256_set1_epi8(static_cast<char>(0xFF)),
+        _mm_load_si128(reinterpret_cast<const __m128i *>(INCOMPLETE_MAX)), 1);
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i prev = zero, prev_incomplete = zero;
+    size_type i = 0;
+    for (; n - i >= 32; i += 32) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        __m256i error = prev_incomplete;
+        if (_mm256_movemask_epi8(in) != 0) {
+            // alignr 只在 128 位通道内移位, 先拼出 (prev 高半, in 低半)
+            __m256i shifted = _mm256_permute2x128_si256(prev, in, 0x21);
+            __m256i prev1 = _mm256_alignr_epi8(in, shifted, 15);
+            __m256i sc = _mm256_and_si256(
+                _mm256_and_si256(
+                    _mm256_shuffle_epi8(byte_1_high,
+                                        _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble)),
+                    _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, low_nibble))),
+                _mm256_shuffle_epi8(byte_2_high,
+                                    _mm256_and_si256(_mm256_srli_epi16(in, 4), low_nibble)));
+            __m256i third =
+                _mm256_subs_epu8(_mm256_alignr_epi8(in, shifted, 14), _mm256_set1_epi8(0x60));
+            __m256i fourth =
+                _mm256_subs_epu8(_mm256_alignr_epi8(in, shifted, 13), _mm256_set1_epi8(0x70));
+            __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth),
+                                              _mm256_set1_epi8(static_cast<char>(0x80)));
+            error = _mm256_or_si256(error, _mm256_xor_si256(must23, sc));
+            prev_incomplete = _mm256_subs_epu8(in, incomplete_max);
+        } else {
+            prev_incomplete = zero;
+        }
+        if (!_mm256_testz_si256(error, error)) return locate_invalid(data, n, i);
+        prev = in;
+    }
+    return locate_invalid(data, n, i);
+}
+#endif
+
+using validate_fn = size_type (*)(const char *, size_type);
+
+size_type validate_fallback(const char *data, size_type n) { return validate_scalar(data, n, 0); }
+
+validate_fn select_validate() {
+#if defined(ALG_X86)
+    if (cpu::has_avx2()) return validate_avx2;
+    if (cpu::has_ssse3()) return validate_ssse3;
+#endif
+    return validate_fallback;
+}
+
+// 解码已校验过的 UTF-8, 连续 8 个 ASCII 字节一次判断
+template <typename Emit>
+void decode_valid_utf8(const char *data, size_type n, Emit emit) {
+    const unsigned char *s = reinterpret_cast<const unsigned char *>(data);
+    size_type i = 0;
+    while (i < n) {
+        if (n - i >= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, s + i, 8);
+            if ((word & 0x8080808080808080ull) == 0) {
+                for (size_type k = 0; k != 8; ++k) emit(static_cast<char32_t>(s[i + k]));
+                i += 8;
+                continue;
+            }
+        }
+        unsigned char b = s[i];
+        if (b < 0x80) {
+            emit(static_cast<char32_t>(b));
+            i += 1;
+        } else if (b < 0xE0) {
+            emit(static_cast<char32_t>(((b & 0x1F) << 6) | (s[i + 1] & 0x3F)));
+            i += 2;
+        } else if (b < 0xF0) {
+            emit(static_cast<char32_t>(((b & 0x0F) << 12) | ((s[i + 1] & 0x3F) << 6) |
+                                       (s[i + 2] & 0x3F)));
+            i += 3;
+        } else {
+            emit(static_cast<char32_t>(((b & 0x07) << 18) | ((s[i + 1] & 0x3F) << 12) |
+                                       ((s[i + 2] & 0x3F) << 6) | (s[i + 3] & 0x3F)));
+            i += 4;
+        }
+    }
+}
+
+size_type encode_utf8(char32_t cp, char *dst) {
+    if (cp < 0x80) {
+        dst[0] = static_cast<char>(cp);
+        return 1;
+    } else if (cp < 0x800) {
+        dst[0] = static_cast<char>(0xC0 | (cp >> 6));
+        dst[1] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 2;
+    } else if (cp < 0x10000) {
+        dst[0] = static_cast<char>(0xE0 | (cp >> 12));
+        dst[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        dst[2] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    dst[0] = static_cast<char>(0xF0 | (cp >> 18));
+    dst[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    dst[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    dst[3] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+bool is_surrogate(char32_t cp) { return cp >= 0xD800 && cp <= 0xDFFF; }
+
+}  // namespace
+
+std::string::size_type utf8_validate(std::string_view str) {
+    static const validate_fn impl = select_validate();
+    return impl(str.data(), str.size());
+}
+
+std::string::size_type utf8_to_utf16(std::string_view str, std::u16string &out) {
+    size_type error = utf8_validate(str);
+    size_type valid = error == std::string::npos ? str.size() : error;
+    out.resize(valid);  // 每个字节最多产生一个 UTF-16 码元
+    size_type written = 0;
+    decode_valid_utf8(str.data(), valid, [&out, &written](char32_t cp) {
+        if (cp < 0x10000) {
+            out[written++] = static_cast<char16_t>(cp);
+        } else {
+            cp -= 0x10000;
+            out[written++] = static_cast<char16_t>(0xD800 | (cp >> 10));
+            out[written++] = static_cast<char16_t>(0xDC00 | (cp & 0x3FF));
+        }
+    });
+    out.resize(written);
+    return error;
+}
+
+std::string::size_type utf8_to_utf32(std::string_view str, std::u32string &out) {
+    size_type error = utf8_validate(str);
+    size_type valid = error == std::string::npos ? str.size() : error;
+    out.resize(valid);
+    size_type written = 0;
+    decode_valid_utf8(str.data(), valid,
+                      [&out, &written](char32_t cp) { out[written++] = cp; });
+    out.resize(written);
+    return error;
+}
+
+std::string::size_type utf16_to_utf8(std::u16string_view str, std::string &out) {
+    out.resize(str.size() * 3);  // 单个码元最多 3 字节, 代理对 2 个码元 4 字节
+    size_type written = 0, i = 0, error = std::string::npos;
+    while (i < str.size()) {
+        char32_t cp = str[i];
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+            if (i + 1 == str.size() || str[i + 1] < 0xDC00 || str[i + 1] > 0xDFFF) {
+                error = i;
+                break;
+            }
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (str[i + 1] - 0xDC00);
+            i += 2;
+        } else if (is_surrogate(cp)) {
+            error = i;
+            break;
+        } else {
+            i += 1;
+        }
+        written += encode_utf8(cp, &out[written]);
+    }
+    out.resize(written);
+    return error;
+}
+
+std::string::size_type utf32_to_utf8(std::u32string_view str, std::string &out) {
+    out.resize(str.size() * 4);
+    size_type written = 0, error = std::string::npos;
+    for (size_type i = 0; i != str.size(); ++i) {
+        if (str[i] > 0x10FFFF || is_surrogate(str[i])) {
+            error = i;
+            break;
+        }
+        written += encode_utf8(str[i], &out[written]);
+    }
+    out.resize(written);
+    return error;
+}
+
 }  // namespace alg
@@ -0,0 +1,155 @@
+#include "utf8_search.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "cpu.hpp"
+
+#if defined(ALG_X86)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace alg {
+
+namespace {
+
+using size_type = std::string::size_type;
+
+// 候选筛选: 返回匹配位置或 npos, scanned 为尚未检查的第一个起始位置
+using filter_fn = size_type (*)(const char *, size_type, const char *, size_type, size_type &);
+
+#if defined(ALG_X86)
+unsigned trailing_zeros(std::uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return idx;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// 文本中 i 处等于模式首字节, 且 i + m - 1 处等于模式尾字节的位置才需要比较中间部分
+ALG_TARGET("sse2")
+size_type filter_sse2(const char *h, size_type n, const char *nd, size_type m, size_type &scanned) {
+    const __m128i first = _mm_set1_epi8(nd[0]);
+    const __m128i last = _mm_set1_epi8(nd[m - 1]);
+    size_type i = 0;
+    for (; n - i >= m - 1 + 16; i += 16) {
+        __m128i bf = _mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i));
+        __m128i bl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i + m - 1));
+        std::uint32_t mask =
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl)));
+        for (; mask != 0; mask &= mask - 1) {
+            size_type k = i + trailing_zeros(mask);
+            if (std::memcmp(h + k + 1, nd + 1, m - 2) == 0) return k;
+        }
+    }
+    scanned = i;
+    return std::string::npos;
+}
+
+ALG_TARGET("avx2")
+size_type filter_avx2(const char *h, size_type n, const char *nd, size_type m, size_type &scanned) {
+    const __m256i first = _mm256_set1_epi8(nd[0]);
+    const __m256i last = _mm256_set1_epi8(nd[m - 1]);
+    size_type i = 0;
+    for (; n - i >= m - 1 + 32; i += 32) {
+        __m256i bf = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + i));
+        __m256i bl = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + i + m - 1));
+        std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(last, bl))));
+        for (; mask != 0; mask &= mask - 1) {
+            size_type k = i + trailing_zeros(mask);
+            if (std::memcmp(h + k + 1, nd + 1, m - 2) == 0) return k;
+        }
+    }
+    scanned = i;
+    return std::string::npos;
+}
+#endif
+
+size_type filter_none(const char *, size_type, const char *, size_type, size_type &scanned) {
+    scanned = 0;
+    return std::string::npos;
+}
+
+filter_fn select_filter() {
+#if defined(ALG_X86)
+    if (cpu::has_avx2()) return filter_avx2;
+    if (cpu::has_sse2()) return filter_sse2;
+#endif
+    return filter_none;
+}
+
+}  // namespace
+
+Utf8Searcher::Utf8Searcher(std::string needle) : _needle(std::move(needle)) {
+    size_type m = _needle.size();
+    for (size_type &s : _shift) s = m;
+    for (size_type i = 0; i + 1 < m; ++i) {
+        _shift[static_cast<unsigned char>(_needle[i])] = m - 1 - i;
+    }
+}
+
+Utf8Match Utf8Searcher::find(std::string_view haystack) const {
+    size_type pos = find_bytes(haystack);
+    if (pos == npos) return Utf8Match();
+    return Utf8Match{pos, utf8_walk_length(haystack.data(), pos), 0};
+}
+
+Utf8Searcher::size_type Utf8Searcher::find_bytes(std::string_view haystack, size_type pos) const {
+    static const filter_fn filter = select_filter();
+    size_type m = _needle.size();
+    if (pos > haystack.size() || m > haystack.size() - pos) return npos;
+    if (m == 0) return pos;
+    const char *h = haystack.data() + pos;
+    size_type n = haystack.size() - pos;
+    if (m == 1) {
+        const void *p = std::memchr(h, _needle[0], n);
+        return p ? pos + (static_cast<const char *>(p) - h) : npos;
+    }
+    size_type scanned = 0;
+    size_type r = filter(h, n, _needle.data(), m, scanned);
+    if (r != npos) return pos + r;
+    r = find_horspool(h + scanned, n - scanned);
+    return r == npos ? npos : pos + scanned + r;
+}
+
+Utf8Searcher::size_type Utf8Searcher::find_horspool(const char *haystack, size_type n) const {
+    size_type m = _needle.size();
+    char last = _needle[m - 1];
+    for (size_type i = 0; n - i >= m;) {
+        char c = haystack[i + m - 1];
+        if (c == last && std::memcmp(haystack + i, _needle.data(), m - 1) == 0) return i;
+        i += _shift[static_cast<unsigned char>(c)];
+    }
+    return npos;
+}
+
+Utf8MultiSearcher::Utf8MultiSearcher(const std::vector<std::string> &needles) {
+    _searchers.reserve(needles.size());
+    for (const std::string &needle : needles) _searchers.emplace_back(needle);
+}
+
+Utf8Match Utf8MultiSearcher::find(std::string_view haystack) const {
+    Utf8Match best;
+    for (size_type k = 0; k != _searchers.size(); ++k) {
+        // 只需要在已知的最好位置之前查找
+        size_type limit = best ? best.byte_offset + _searchers[k].needle().size() : haystack.size();
+        if (limit > haystack.size()) limit = haystack.size();
+        size_type pos = _searchers[k].find_bytes(haystack.substr(0, limit));
+        if (pos != npos && pos < best.byte_offset) {
+            best.byte_offset = pos;
+            best.needle = k;
+        }
+    }
+    if (best) best.char_offset = utf8_walk_length(haystack.data(), best.byte_offset);
+    return best;
+}
+
+}  // namespace alg
@@ -0,0 +1,82 @@
+#include "utf8_view.hpp"
+
+#include <stdexcept>
+
+#include "string.hpp"
+
+namespace alg {
+
+namespace {
+
+using size_type = Utf8View::size_type;
+
+bool is_continuation(char b) { return (b & 0xC0) == 0x80; }
+
+size_type next_boundary(std::string_view str, size_type pos) {
+    for (++pos; pos < str.size() && is_continuation(str[pos]); ++pos) continue;
+    return pos;
+}
+size_type prev_boundary(std::string_view str, size_type pos) {
+    for (--pos; pos > 0 && is_continuation(str[pos]); --pos) continue;
+    return pos;
+}
+
+}  // namespace
+
+std::string_view Utf8View::const_iterator::operator*() const {
+    return _str.substr(_pos, next_boundary(_str, _pos) - _pos);
+}
+Utf8View::const_iterator &Utf8View::const_iterator::operator++() {
+    _pos = next_boundary(_str, _pos);
+    return *this;
+}
+Utf8View::const_iterator &Utf8View::const_iterator::operator--() {
+    _pos = prev_boundary(_str, _pos);
+    return *this;
+}
+
+std::string_view Utf8View::char_at(size_type idx) const {
+    size_type pos = walk_to(idx);
+    if (pos == npos || pos == _str.size()) throw std::out_of_range("Index out of range.");
+    return _str.substr(pos, next_boundary(_str, pos) - pos);
+}
+
+Utf8View::size_type Utf8View::byte_offset(size_type idx) const {
+    size_type pos = walk_to(idx);
+    if (pos == npos) throw std::out_of_range("Index out of range.");
+    return pos;
+}
+
+Utf8View Utf8View::substr(size_type pos, size_type count) const {
+    size_type first = byte_offset(pos);
+    size_type last = count >= npos - pos ? npos : walk_to(pos + count);
+    if (last == npos) last = _str.size();
+    return Utf8View(_str.substr(first, last - first));
+}
+
+Utf8View::size_type Utf8View::size() const {
+    if (_size == npos) _size = utf8_walk_length(_str);
+    return _size;
+}
+
+Utf8View::size_type Utf8View::walk_to(size_type idx) const {
+    if (_index.empty()) _index.push_back(0);
+    size_type k = idx / INDEX_STRIDE;
+    // 索引只向后扩展到需要的检查点为止
+    while (_index.size() <= k && !_index_complete) {
+        size_type pos = _index.back(), n = 0;
+        for (; n != INDEX_STRIDE && pos != _str.size(); ++n) pos = next_boundary(_str, pos);
+        if (n == INDEX_STRIDE && pos != _str.size()) {
+            _index.push_back(pos);
+        } else {
+            _index_complete = true;
+            _size = (_index.size() - 1) * INDEX_STRIDE + n;
+        }
+    }
+    if (k >= _index.size()) k = _index.size() - 1;
+    size_type i = k * INDEX_STRIDE, pos = _index[k];
+    for (; i != idx && pos != _str.size(); ++i) pos = next_boundary(_str, pos);
+    return i == idx ? pos : npos;
+}
+
+}  // namespace alg
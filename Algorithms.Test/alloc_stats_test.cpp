@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "alloc_stats.hpp"
+#include "resizing_array.hpp"
+#include "stack.hpp"
+#include "vector.hpp"
+
+namespace alg::test {
+
+namespace {
+struct VectorTag {
+    static constexpr const char *name = "test.vector";
+};
+struct StackTag {
+    static constexpr const char *name = "test.stack";
+};
+struct ThreadTag {
+    static constexpr const char *name = "test.threads";
+};
+}  // namespace
+
+TEST(AllocStats, TracksContainerGrowth) {
+    AllocStats &stats = AllocStats::for_tag("test.vector");
+    stats.reset();
+    {
+        Vector<int, StatsAllocator<int, VectorTag>> v;
+        for (int i = 0; i != 1000; ++i) v.push_back(i);
+
+        AllocStats::Snapshot s = stats.snapshot();
+        EXPECT_GT(s.allocations, 1u);
+        EXPECT_EQ(s.allocations - 1, s.deallocations);
+        EXPECT_EQ(v.capacity() * sizeof(int), s.live_bytes);
+        EXPECT_GE(s.peak_live_bytes, s.live_bytes);
+        size_t total = 0;
+        for (size_t count : s.histogram) total += count;
+        EXPECT_EQ(s.allocations, total);
+    }
+    AllocStats::Snapshot s = stats.snapshot();
+    EXPECT_EQ(0u, s.live_bytes);
+    EXPECT_EQ(s.allocations, s.deallocations);
+}
+TEST(AllocStats, SeparatesTags) {
+    AllocStats::for_tag("test.stack").reset();
+    size_t vector_allocations = AllocStats::for_tag("test.vector").snapshot().allocations;
+    {
+        Stack<int, ResizingArray<int, StatsAllocator<int, StackTag>>> s;
+        for (int i = 0; i != 100; ++i) s.push(i);
+    }
+    EXPECT_GT(AllocStats::for_tag("test.stack").snapshot().allocations, 0u);
+    EXPECT_EQ(vector_allocations, AllocStats::for_tag("test.vector").snapshot().allocations);
+    EXPECT_EQ(&AllocStats::for_tag("test.stack"), (&StatsAllocator<char, StackTag>::stats()));
+
+    bool found = false;
+    for (const AllocStats::Snapshot &s : AllocStats::all()) found |= s.tag == "test.stack";
+    EXPECT_TRUE(found);
+}
+TEST(AllocStats, ThreadSafe) {
+    AllocStats &stats = AllocStats::for_tag("test.threads");
+    stats.reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t != 4; ++t) {
+        threads.emplace_back([] {
+            StatsAllocator<double, ThreadTag> alloc;
+            for (int i = 0; i != 1000; ++i) alloc.deallocate(alloc.allocate(4), 4);
+        });
+    }
+    for (auto &t : threads) t.join();
+    AllocStats::Snapshot s = stats.snapshot();
+    EXPECT_EQ(4000u, s.allocations);
+    EXPECT_EQ(4000u, s.deallocations);
+    EXPECT_EQ(4000u * 4 * sizeof(double), s.bytes_allocated);
+    EXPECT_EQ(0u, s.live_bytes);
+    EXPECT_EQ(4000u, s.histogram[5]);
+}
+
+}  // namespace alg::test
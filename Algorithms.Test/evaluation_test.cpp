@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
 #include "evaluation.hpp"
+#include "expression_cache.hpp"
 
 #include <cmath>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace alg::test {
 
@@ -15,4 +20,104 @@ TEST(DijkstraExpressionEvaluation, Function) {
     EXPECT_EQ((1 + std::sqrt(5.0)) / 2.0, result);
 }
 
+TEST(DijkstraExpressionEvaluation, Malformed) {
+    EXPECT_THROW(evaluate("( 1 + )"), std::invalid_argument);
+    EXPECT_THROW(evaluate("( 1 + x )"), std::invalid_argument);
+    // 没有右括号的一元运算符不能被丢弃
+    EXPECT_THROW(evaluate("sqrt 4"), std::invalid_argument);
+    EXPECT_THROW(evaluate("( sqrt 4"), std::invalid_argument);
+}
+
+TEST(Expression, Variables) {
+    Expression e("( ( x + y ) * x )");
+    ASSERT_EQ(2, e.variables().size());
+    EXPECT_EQ("x", e.variables()[0]);
+    EXPECT_EQ("y", e.variables()[1]);
+    double vals[] = {3.0, 4.0};
+    EXPECT_EQ((3.0 + 4.0) * 3.0, e.evaluate(vals));
+    // 有变量时不能省略 vals
+    EXPECT_THROW(e.evaluate(), std::invalid_argument);
+    double out[1];
+    EXPECT_THROW(e.evaluate(nullptr, 1, out), std::invalid_argument);
+    ExpressionCache cache(4);
+    EXPECT_THROW(cache.evaluate("( x + 1 )"), std::invalid_argument);
+    EXPECT_EQ(4, cache.evaluate("( x + 1 )", vals));
+}
+
+TEST(Expression, Columns) {
+    Expression e("( ( sqrt ( ( a * a ) + ( b * b ) ) ) / ( a - 0.5 ) )");
+    const size_t n = 1000;  // 不是块大小和向量宽度的整数倍
+    std::vector<double> a(n), b(n), out(n);
+    for (size_t i = 0; i != n; ++i) {
+        a[i] = i * 0.25;
+        b[i] = 1000.0 - i;
+    }
+    const double *columns[] = {a.data(), b.data()};
+    e.evaluate(columns, n, out.data());
+    for (size_t i = 0; i != n; ++i) {
+        double vals[] = {a[i], b[i]};
+        EXPECT_DOUBLE_EQ(e.evaluate(vals), out[i]);
+    }
+}
+
+TEST(Expression, SingleOperand) {
+    Expression c("2.5"), v("x");
+    std::vector<double> x = {1, 2, 3}, out(3);
+    const double *columns[] = {x.data()};
+    c.evaluate(nullptr, out.size(), out.data());
+    EXPECT_EQ(std::vector<double>({2.5, 2.5, 2.5}), out);
+    v.evaluate(columns, out.size(), out.data());
+    EXPECT_EQ(x, out);
+}
+
+TEST(ExpressionCache, HitAndMiss) {
+    ExpressionCache cache(4);
+    auto e1 = cache.get("( 1 + 2 )");
+    auto e2 = cache.get(std::string("( 1 + 2 )"));
+    EXPECT_EQ(e1, e2);
+    EXPECT_EQ(1, cache.hits());
+    EXPECT_EQ(1, cache.misses());
+    EXPECT_EQ(3, cache.evaluate("( 1 + 2 )"));
+    EXPECT_EQ(1, cache.size());
+}
+
+TEST(ExpressionCache, Eviction) {
+    ExpressionCache cache(2, 1);
+    cache.get("1");
+    cache.get("2");
+    cache.get("1");  // "2" 成为最久未使用的
+    cache.get("3");
+    EXPECT_EQ(2, cache.size());
+    size_t misses = cache.misses();
+    cache.get("1");
+    EXPECT_EQ(misses, cache.misses());
+    cache.get("2");
+    EXPECT_EQ(misses + 1, cache.misses());
+}
+
+TEST(ExpressionCache, Capacity) {
+    // 容量不是分片数的整数倍时, 总容量仍然是请求的值
+    ExpressionCache cache(17);
+    EXPECT_EQ(17, cache.capacity());
+    for (int i = 0; i != 1000; ++i) cache.get(std::to_string(i));
+    EXPECT_EQ(17, cache.size());
+    EXPECT_EQ(3, ExpressionCache(3).capacity());
+}
+
+TEST(ExpressionCache, Concurrent) {
+    ExpressionCache cache(8);
+    std::vector<std::thread> threads;
+    for (int t = 0; t != 4; ++t) {
+        threads.emplace_back([&cache] {
+            for (int i = 0; i != 1000; ++i) {
+                double x = i % 16;
+                EXPECT_EQ(x * 2, cache.evaluate("( x + x )", &x));
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+    EXPECT_EQ(4000, cache.hits() + cache.misses());
+    EXPECT_EQ(1, cache.size());
+}
+
 }  // namespace alg::test
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "flat_map.hpp"
+
+namespace alg::test {
+
+TEST(FlatSet, BulkConstruct) {
+    FlatSet<int> s(Vector<int>({5, 3, 9, 3, 1, 5}));
+    EXPECT_EQ(Vector<int>({1, 3, 5, 9}), s.keys());
+    EXPECT_TRUE(s.contains(9));
+    EXPECT_FALSE(s.contains(4));
+    EXPECT_EQ(s.begin() + 2, s.lower_bound(4));
+}
+TEST(FlatSet, InsertErase) {
+    FlatSet<std::string, std::greater<std::string>> s;
+    EXPECT_TRUE(s.insert("b"));
+    EXPECT_TRUE(s.insert("a"));
+    EXPECT_TRUE(s.insert("c"));
+    EXPECT_FALSE(s.insert("b"));
+    EXPECT_EQ(Vector<std::string>({"c", "b", "a"}), s.keys());
+    EXPECT_TRUE(s.erase("b"));
+    EXPECT_FALSE(s.erase("b"));
+    EXPECT_EQ(Vector<std::string>({"c", "a"}), s.keys());
+}
+TEST(FlatSet, BatchInsert) {
+    FlatSet<int> s = {10, 20, 30};
+    int more[] = {35, 5, 20, 15, 5, 25};
+    s.insert(std::begin(more), std::end(more));
+    EXPECT_EQ(Vector<int>({5, 10, 15, 20, 25, 30, 35}), s.keys());
+}
+TEST(FlatMap, Lookup) {
+    FlatMap<std::string, int> m = {{"b", 2}, {"a", 1}, {"c", 3}, {"a", 100}};
+    ASSERT_EQ(3u, m.size());
+    EXPECT_EQ(Vector<std::string>({"a", "b", "c"}), m.keys());
+    EXPECT_EQ(Vector<int>({1, 2, 3}), m.values());
+    EXPECT_EQ(2, m.at("b"));
+    EXPECT_THROW(m.at("d"), std::out_of_range);
+    EXPECT_EQ(nullptr, m.find("d"));
+    *m.find("c") = 30;
+    EXPECT_EQ(30, m.value_at(2));
+    EXPECT_EQ((FlatMap<std::string, int>::npos), m.index_of("0"));
+}
+TEST(FlatMap, Modify) {
+    FlatMap<int, std::string> m;
+    EXPECT_TRUE(m.insert(2, "two"));
+    EXPECT_FALSE(m.insert(2, "deux"));
+    EXPECT_FALSE(m.insert_or_assign(2, "deux"));
+    m[1] = "one";
+    m[3];
+    EXPECT_EQ(Vector<int>({1, 2, 3}), m.keys());
+    EXPECT_EQ(Vector<std::string>({"one", "deux", ""}), m.values());
+    EXPECT_TRUE(m.erase(2));
+    EXPECT_FALSE(m.contains(2));
+    EXPECT_EQ(Vector<std::string>({"one", ""}), m.values());
+}
+TEST(FlatMap, BatchInsert) {
+    FlatMap<int, int> m(Vector<int>({40, 10, 30}), Vector<int>({4, 1, 3}));
+    m.insert(Vector<int>({20, 50, 10, 0, 20}), Vector<int>({2, 5, -1, 0, -2}));
+    EXPECT_EQ(Vector<int>({0, 10, 20, 30, 40, 50}), m.keys());
+    EXPECT_EQ(Vector<int>({0, 1, 2, 3, 4, 5}), m.values());
+    EXPECT_THROW(m.insert(Vector<int>({1}), Vector<int>()), std::invalid_argument);
+}
+
+}  // namespace alg::test
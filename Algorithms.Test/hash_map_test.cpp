@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "alloc_stats.hpp"
+#include "hash_map.hpp"
+
+namespace alg::test {
+
+namespace {
+struct HashMapTag {
+    static constexpr const char *name = "test.hash_map";
+};
+}  // namespace
+
+TEST(HashMap, InsertFind) {
+    HashMap<int, std::string> m;
+    EXPECT_TRUE(m.insert({1, "one"}).second);
+    EXPECT_FALSE(m.insert({1, "uno"}).second);
+    m[2] = "two";
+    m.insert_or_assign(3, "three");
+    m.insert_or_assign(3, "drei");
+    EXPECT_EQ(3u, m.size());
+    EXPECT_EQ("one", m.at(1));
+    EXPECT_EQ("drei", m.find(3)->second);
+    EXPECT_EQ(m.end(), m.find(4));
+    EXPECT_THROW(m.at(4), std::out_of_range);
+
+    size_t count = 0;
+    for (auto &kv : m) count += kv.first;
+    EXPECT_EQ(6u, count);
+}
+TEST(HashMap, StringViewLookup) {
+    HashMap<std::string, int> m = {{"alpha", 1}, {"beta", 2}};
+    std::string_view key = "beta";
+    EXPECT_EQ(2, m.at(key));
+    EXPECT_TRUE(m.contains("alpha"));
+    EXPECT_FALSE(m.contains(std::string_view("gamma")));
+    EXPECT_EQ(1u, m.erase(std::string_view("alpha")));
+    EXPECT_EQ(1u, m.size());
+}
+TEST(HashMap, MatchesUnorderedMap) {
+    HashMap<unsigned, unsigned> m;
+    std::unordered_map<unsigned, unsigned> expected;
+    std::mt19937 rand(42);
+    for (int i = 0; i != 200000; ++i) {
+        unsigned key = rand() % 5000, op = rand() % 3;
+        if (op == 0) {
+            EXPECT_EQ(expected.erase(key), m.erase(key));
+        } else {
+            m[key] = i;
+            expected[key] = i;
+        }
+    }
+    ASSERT_EQ(expected.size(), m.size());
+    for (auto &kv : expected) EXPECT_EQ(kv.second, m.at(kv.first));
+    size_t visited = 0;
+    for (auto iter = m.begin(); iter != m.end(); ++iter) ++visited;
+    EXPECT_EQ(expected.size(), visited);
+    EXPECT_LE(m.load_factor(), 0.875);
+}
+TEST(HashMap, EraseWhileIterating) {
+    HashMap<int, int> m;
+    for (int i = 0; i != 1000; ++i) m[i] = i;
+    for (auto iter = m.begin(); iter != m.end();) {
+        if (iter->first % 3 == 0)
+            iter = m.erase(iter);
+        else
+            ++iter;
+    }
+    EXPECT_EQ(666u, m.size());
+    EXPECT_FALSE(m.contains(999));
+    EXPECT_TRUE(m.contains(998));
+}
+TEST(HashMap, CopyMoveAndAllocator) {
+    AllocStats &stats = AllocStats::for_tag(HashMapTag::name);
+    stats.reset();
+    {
+        using Map = HashMap<std::string, int, Hash<std::string>, std::equal_to<>,
+                            StatsAllocator<std::pair<std::string, int>, HashMapTag>>;
+        Map m;
+        m.reserve(100);
+        size_t capacity = m.capacity();
+        for (int i = 0; i != 100; ++i) m[std::to_string(i)] = i;
+        EXPECT_EQ(capacity, m.capacity());
+
+        Map copy = m;
+        Map moved = std::move(m);
+        EXPECT_EQ(100u, copy.size());
+        EXPECT_EQ(100u, moved.size());
+        EXPECT_EQ(42, copy.at("42"));
+        copy.clear();
+        EXPECT_TRUE(copy.empty());
+        EXPECT_FALSE(copy.contains("42"));
+        EXPECT_GT(stats.snapshot().live_bytes, 0u);
+    }
+    EXPECT_EQ(0u, stats.snapshot().live_bytes);
+}
+TEST(HashMap, ClearKeepsCapacity) {
+    AllocStats &stats = AllocStats::for_tag(HashMapTag::name);
+    using Map = HashMap<int, int, Hash<int>, std::equal_to<>,
+                        StatsAllocator<std::pair<int, int>, HashMapTag>>;
+    Map m;
+    m.reserve(1000);
+    size_t capacity = m.capacity();
+    for (int i = 0; i != 1000; ++i) m[i] = i;
+    ASSERT_EQ(capacity, m.capacity());
+    // 清空满载的表之后重新插入同样多的元素, 不应该重新分配
+    m.clear();
+    size_t allocations = stats.snapshot().allocations;
+    for (int i = 0; i != 1000; ++i) m[i + 1000] = i;
+    EXPECT_EQ(allocations, stats.snapshot().allocations);
+    EXPECT_EQ(capacity, m.capacity());
+    EXPECT_EQ(1000u, m.size());
+}
+
+}  // namespace alg::test
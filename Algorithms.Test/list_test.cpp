@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "alloc_stats.hpp"
+#include "instrument.hpp"
+#include "list.hpp"
+
+namespace alg::test {
+
+namespace {
+struct ListTag {
+    static constexpr const char *name = "test.list";
+};
+
+template <typename T, typename A>
+std::vector<T> to_vector(const List<T, A> &list) {
+    return std::vector<T>(list.begin(), list.end());
+}
+}  // namespace
+
+TEST(ListTest, Basic) {
+    List<int> list{2, 3};
+    list.push_front(1);
+    list.push_back(4);
+    EXPECT_EQ(4u, list.size());
+    EXPECT_EQ(1, list.front());
+    EXPECT_EQ(4, list.back());
+    EXPECT_EQ(std::vector<int>({4, 3, 2, 1}), std::vector<int>(list.rbegin(), list.rend()));
+
+    auto it = list.insert(std::next(list.begin()), 10);
+    EXPECT_EQ(10, *it);
+    it = list.erase(it);
+    EXPECT_EQ(2, *it);
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(std::vector<int>({2, 3}), to_vector(list));
+
+    List<int> copy = list, moved = std::move(list);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(copy, moved);
+    copy.push_back(5);
+    swap(copy, moved);
+    EXPECT_EQ(std::vector<int>({2, 3, 5}), to_vector(moved));
+    EXPECT_EQ(std::vector<int>({2, 3}), to_vector(copy));
+
+    List<int> empty;
+    empty.swap(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(2u, empty.size());
+    copy.push_back(1);
+    EXPECT_EQ(1, copy.front());
+}
+TEST(ListTest, Merge) {
+    List<int> a{1, 3, 5, 7}, b{0, 3, 4, 8, 9};
+    int *three = &*std::next(a.begin());
+    a.merge(b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(std::vector<int>({0, 1, 3, 3, 4, 5, 7, 8, 9}), to_vector(a));
+    // 节点没有复制, 相等时 a 的元素在前
+    EXPECT_EQ(three, &*std::next(a.begin(), 2));
+
+    List<int> c{10, 2};
+    a.splice(a.begin(), c);
+    EXPECT_EQ(11u, a.size());
+    EXPECT_EQ(10, a.front());
+}
+TEST(ListTest, SortIsStable) {
+    std::mt19937 rand(23);
+    for (size_t n : {0, 1, 2, 3, 100, 10000}) {
+        List<std::pair<int, size_t>> list;
+        for (size_t i = 0; i != n; ++i) list.push_back({static_cast<int>(rand() % 50), i});
+        std::vector<std::pair<int, size_t>> expected = to_vector(list);
+        auto by_key = [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; };
+        std::stable_sort(expected.begin(), expected.end(), by_key);
+        list.sort(by_key);
+        EXPECT_EQ(expected, to_vector(list));
+        EXPECT_EQ(n, list.size());
+        if (n != 0) {
+            EXPECT_EQ(expected.back(), *list.rbegin());
+        }
+    }
+}
+TEST(ListTest, SortUsesRunsWithoutAllocating) {
+    using StatsList = List<int, StatsAllocator<int, ListTag>>;
+    StatsList asc, desc, mixed;
+    for (int i = 0; i != 100000; ++i) {
+        asc.push_back(i);
+        desc.push_back(-i);
+        // 几个较长的有序段交替
+        mixed.push_back((i / 10000) % 2 == 0 ? i : -i);
+    }
+    AllocStats::Snapshot before = StatsAllocator<int, ListTag>::stats().snapshot();
+    OpCounts counts;
+    {
+        CountOps scope(counts);
+        asc.sort(counting(std::less<int>()));
+        desc.sort(counting(std::less<int>()));
+    }
+    mixed.sort();
+    AllocStats::Snapshot after = StatsAllocator<int, ListTag>::stats().snapshot();
+    EXPECT_EQ(before.allocations, after.allocations);
+    // 有序和严格递减的输入都只是一个 run
+    EXPECT_EQ(2u * (100000 - 1), counts.comparisons);
+    EXPECT_TRUE(std::is_sorted(asc.begin(), asc.end()));
+    EXPECT_TRUE(std::is_sorted(desc.begin(), desc.end()));
+    EXPECT_TRUE(std::is_sorted(mixed.begin(), mixed.end()));
+    EXPECT_EQ(-99999, desc.front());
+}
+
+}  // namespace alg::test
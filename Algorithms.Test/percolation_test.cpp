@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "percolation.hpp"
+#include "union_find/quick_find.hpp"
+#include "union_find/quick_union.hpp"
+#include "union_find/rollback_union_find.hpp"
+
+namespace alg::test {
+
+TEST(Percolation, Basic) {
+    Percolation<QuickUnion> perc(3);
+    EXPECT_FALSE(perc.percolates());
+    perc.open(0, 1);
+    perc.open(1, 1);
+    perc.open(1, 1);
+    EXPECT_EQ(2u, perc.open_count());
+    EXPECT_TRUE(perc.is_full(1, 1));
+    EXPECT_FALSE(perc.is_full(1, 0));
+    perc.open(2, 0);
+    EXPECT_FALSE(perc.percolates());
+    EXPECT_FALSE(perc.is_full(2, 0));
+    perc.open(1, 0);
+    EXPECT_TRUE(perc.percolates());
+    EXPECT_TRUE(perc.is_full(2, 0));
+    EXPECT_THROW(perc.open(3, 0), std::out_of_range);
+
+    Percolation<QuickFind> single(1);
+    single.open(0, 0);
+    EXPECT_TRUE(single.percolates());
+}
+TEST(Percolation, Threshold) {
+    // 正方格点的渗透阈值约为 0.5927
+    PercolationStats stats = estimate_percolation<QuickUnion>(64, 200, 4);
+    EXPECT_EQ(200u, stats.trials);
+    EXPECT_NEAR(0.5927, stats.mean, 0.02);
+    EXPECT_LT(stats.ci_low, stats.mean);
+    EXPECT_GT(stats.ci_high, stats.mean);
+    EXPECT_GT(stats.opened, 200u * 64 * 64 / 2);
+}
+TEST(Percolation, IndependentOfThreadsAndUnionFind) {
+    PercolationStats a = estimate_percolation<QuickUnion>(20, 16, 1, 7);
+    PercolationStats b = estimate_percolation<QuickUnion>(20, 16, 3, 7);
+    PercolationStats c = estimate_percolation<RollbackUnionFind>(20, 16, 0, 7);
+    EXPECT_EQ(a.mean, b.mean);
+    EXPECT_EQ(a.mean, c.mean);
+    EXPECT_EQ(a.opened, c.opened);
+    EXPECT_THROW(estimate_percolation<QuickUnion>(20, 1), std::invalid_argument);
+}
+
+}  // namespace alg::test
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+namespace alg::test {
+
+TEST(PriorityQueue, PushPop) {
+    PriorityQueue<int> pq;
+    for (int v : {5, 1, 8, 3, 9, 2}) pq.push(v);
+    pq.emplace(7);
+    EXPECT_EQ(7u, pq.size());
+    EXPECT_EQ(9, pq.top());
+    std::vector<int> out;
+    while (!pq.empty()) out.push_back(pq.pop());
+    EXPECT_EQ(std::vector<int>({9, 8, 7, 5, 3, 2, 1}), out);
+}
+TEST(PriorityQueue, Heapify) {
+    std::mt19937 rand(7);
+    std::vector<int> values;
+    for (int i = 0; i != 1000; ++i) values.push_back(rand() % 100);
+    PriorityQueue<int, ResizingArray<int>, std::greater<int>, 8> pq(values.begin(), values.end());
+    pq.push_range(values.begin(), values.begin() + 10);
+    int prev = pq.pop();
+    while (!pq.empty()) {
+        int v = pq.pop();
+        EXPECT_LE(prev, v);
+        prev = v;
+    }
+}
+TEST(PriorityQueue, MoveOnly) {
+    using Ptr = std::unique_ptr<int>;
+    auto by_value = [](const Ptr &lhs, const Ptr &rhs) { return *lhs < *rhs; };
+    PriorityQueue<Ptr, ResizingArray<Ptr>, decltype(by_value), 2> pq(by_value);
+    for (int v : {2, 3, 1}) pq.push(std::make_unique<int>(v));
+    pq.emplace(new int(4));
+    EXPECT_EQ(4, *pq.top());
+    Ptr top = pq.pop();
+    EXPECT_EQ(4, *top);
+    EXPECT_EQ(3, *pq.pop());
+    EXPECT_EQ(2, *pq.pop());
+    EXPECT_EQ(1, *pq.pop());
+    EXPECT_TRUE(pq.empty());
+}
+TEST(IndexedPriorityQueue, DecreaseKey) {
+    IndexedPriorityQueue<double> pq(5);
+    pq.push(0, 5.0);
+    pq.push(1, 3.0);
+    pq.push(2, 4.0);
+    pq.push(3, 1.0);
+    EXPECT_EQ(3u, pq.top());
+    pq.decrease_key(2, 0.5);
+    EXPECT_EQ(2u, pq.top());
+    EXPECT_THROW(pq.decrease_key(0, 6.0), std::invalid_argument);
+    pq.change_key(2, 10.0);
+    EXPECT_EQ(3u, pq.pop());
+    pq.erase(1);
+    EXPECT_FALSE(pq.contains(1));
+    EXPECT_EQ(0u, pq.pop());
+    EXPECT_EQ(2u, pq.pop());
+    EXPECT_TRUE(pq.empty());
+    EXPECT_THROW(pq.push(5, 1.0), std::out_of_range);
+}
+TEST(IndexedPriorityQueue, Dijkstra) {
+    // 0 -> 1 (4), 0 -> 2 (1), 2 -> 1 (2), 1 -> 3 (1), 2 -> 3 (5)
+    struct Edge {
+        size_t to;
+        double weight;
+    };
+    std::vector<std::vector<Edge>> adj = {{{1, 4}, {2, 1}}, {{3, 1}}, {{1, 2}, {3, 5}}, {}};
+    std::vector<double> dist(adj.size(), 1e9);
+    IndexedPriorityQueue<double> pq(adj.size());
+    dist[0] = 0;
+    pq.push(0, 0);
+    while (!pq.empty()) {
+        size_t v = pq.pop();
+        for (const Edge &e : adj[v]) {
+            if (dist[v] + e.weight >= dist[e.to]) continue;
+            dist[e.to] = dist[v] + e.weight;
+            if (pq.contains(e.to))
+                pq.decrease_key(e.to, dist[e.to]);
+            else
+                pq.push(e.to, dist[e.to]);
+        }
+    }
+    EXPECT_EQ(std::vector<double>({0, 3, 1, 4}), dist);
+}
+
+}  // namespace alg::test
@@ -1,9 +1,17 @@
 #include <gtest/gtest.h>
+#include "search/adaptive_search.hpp"
 #include "search/binary_search.hpp"
+#include "search/exponential_search.hpp"
+#include "search/interpolation_search.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <random>
+#include <vector>
 
+#include "instrument.hpp"
 #include "resizing_array.hpp"
+#include "utility.hpp"
 
 namespace alg::test {
 
@@ -15,5 +23,157 @@ TEST(BinarySearchTest, NotContain) {
     ResizingArray<int> v = {1, 2, 3, 4};
     ASSERT_EQ(v.end(), binary_search(v.begin(), v.end(), 5));
 }
+TEST(LowerBoundTest, FirstNotLess) {
+    ResizingArray<int> v = {1, 2, 2, 4};
+    EXPECT_EQ(v.begin() + 1, lower_bound(v.begin(), v.end(), 2));
+    EXPECT_EQ(v.begin() + 3, lower_bound(v.begin(), v.end(), 3));
+    EXPECT_EQ(v.end(), lower_bound(v.begin(), v.end(), 5));
+    ResizingArray<int> desc = {4, 2, 2, 1};
+    EXPECT_EQ(desc.begin() + 1, lower_bound(desc.begin(), desc.end(), 2, compare_desc<int>));
+}
+TEST(BinarySearchTest, CountsComparisons) {
+    ResizingArray<Counted<int>> v;
+    for (int i = 0; i != 1024; ++i) v.push_back(i);
+    OpCounts counts;
+    {
+        CountOps scope(counts);
+        ASSERT_EQ(v.begin() + 700, binary_search(v.begin(), v.end(), Counted<int>(700)));
+    }
+    EXPECT_GT(counts.comparisons, 0u);
+    EXPECT_LE(counts.comparisons, 2u * 11);
+    EXPECT_EQ(0u, counts.copies);
+}
+TEST(LowerBoundTest, UpperBoundAndEqualRange) {
+    ResizingArray<int> v = {1, 2, 2, 2, 4};
+    EXPECT_EQ(v.begin() + 4, upper_bound(v.begin(), v.end(), 2));
+    EXPECT_EQ(v.begin(), upper_bound(v.begin(), v.end(), 0));
+    EXPECT_EQ(v.end(), upper_bound(v.begin(), v.end(), 4));
+    auto range = alg::equal_range(v.begin(), v.end(), 2);
+    EXPECT_EQ(v.begin() + 1, range.first);
+    EXPECT_EQ(v.begin() + 4, range.second);
+    range = alg::equal_range(v.begin(), v.end(), 3);
+    EXPECT_EQ(range.first, range.second);
+    EXPECT_EQ(v.begin() + 4, range.first);
+
+    ResizingArray<int> desc = {4, 2, 2, 1};
+    EXPECT_EQ(desc.begin() + 3, upper_bound(desc.begin(), desc.end(), 2, compare_desc<int>));
+    EXPECT_EQ(desc.begin() + 1, alg::binary_search(desc.begin(), desc.end(), 2, compare_desc<int>));
+    EXPECT_EQ(desc.end(), alg::binary_search(desc.begin(), desc.end(), 3, compare_desc<int>));
+}
+
+namespace {
+// 与 std 的结果逐一比较, 键覆盖区间内外以及重复的值
+template <typename F>
+void check_bounds(const std::vector<int> &v, F f) {
+    for (int key = -2; key <= (v.empty() ? 2 : v.back() + 2); ++key) {
+        size_t lower = std::lower_bound(v.begin(), v.end(), key) - v.begin();
+        size_t upper = std::upper_bound(v.begin(), v.end(), key) - v.begin();
+        f(key, lower, upper);
+    }
+}
+std::vector<int> sorted_random(size_t n, int range, unsigned seed) {
+    std::mt19937 rand(seed);
+    std::vector<int> v(n);
+    for (int &x : v) x = static_cast<int>(rand() % range);
+    std::sort(v.begin(), v.end());
+    return v;
+}
+}  // namespace
+
+TEST(ExponentialSearch, MatchesBinarySearch) {
+    for (size_t n : {0, 1, 2, 3, 17, 1000}) {
+        std::vector<int> v = sorted_random(n, static_cast<int>(n / 3 + 1), 5);
+        check_bounds(v, [&](int key, size_t lower, size_t upper) {
+            ASSERT_EQ(lower, exponential_lower_bound(v.begin(), v.end(), key) - v.begin());
+            ASSERT_EQ(upper, exponential_upper_bound(v.begin(), v.end(), key) - v.begin());
+            for (size_t hint : {size_t(0), n / 2, n}) {
+                ASSERT_EQ(lower,
+                          hinted_lower_bound(v.begin(), v.end(), v.begin() + hint, key) -
+                              v.begin());
+            }
+        });
+    }
+}
+TEST(ExponentialSearch, CostDependsOnDistance) {
+    std::vector<int> v(1 << 20);
+    for (size_t i = 0; i != v.size(); ++i) v[i] = static_cast<int>(i);
+    OpCounts counts;
+    {
+        CountOps scope(counts);
+        EXPECT_EQ(v.begin() + 5,
+                  exponential_lower_bound(v.begin(), v.end(), 5, counting(std::less<>())));
+        EXPECT_EQ(v.begin() + 700003, hinted_lower_bound(v.begin(), v.end(), v.begin() + 700000,
+                                                         700003, counting(std::less<>())));
+    }
+    EXPECT_LE(counts.comparisons, 12u);
+}
+TEST(InterpolationSearch, MatchesBinarySearch) {
+    for (size_t n : {0, 1, 2, 9, 100, 5000}) {
+        std::vector<int> v = sorted_random(n, static_cast<int>(n / 2 + 1), 11);
+        // 偏斜的分布: 插值估计很差, 仍然要正确
+        std::vector<int> skewed(n);
+        for (size_t i = 0; i != n; ++i) skewed[i] = static_cast<int>(i * i / (n + 1));
+        for (const std::vector<int> *data : {&v, &skewed}) {
+            const std::vector<int> &d = *data;
+            check_bounds(d, [&](int key, size_t lower, size_t upper) {
+                ASSERT_EQ(lower, interpolation_lower_bound(d.begin(), d.end(), key) - d.begin());
+                ASSERT_EQ(upper, interpolation_upper_bound(d.begin(), d.end(), key) - d.begin());
+            });
+        }
+    }
+    std::vector<double> d = {0.5, 1.5, 2.5};
+    EXPECT_EQ(d.begin() + 1, interpolation_lower_bound(d.begin(), d.end(), 1.0));
+}
+TEST(InterpolationSearch, FewProbesOnUniformKeys) {
+    std::vector<unsigned> v = {};
+    std::mt19937 rand(3);
+    for (size_t i = 0; i != (1 << 20); ++i) v.push_back(static_cast<unsigned>(rand()));
+    std::sort(v.begin(), v.end());
+    OpCounts binary, interpolation;
+    for (size_t i = 0; i != 1000; ++i) {
+        unsigned key = v[rand() % v.size()];
+        {
+            CountOps scope(binary);
+            alg::lower_bound(v.begin(), v.end(), key, counting(std::less<>()));
+        }
+        CountOps scope(interpolation);
+        auto pos = interpolation_lower_bound(v.begin(), v.end(), key, counting(std::less<>()));
+        ASSERT_EQ(std::lower_bound(v.begin(), v.end(), key), pos);
+    }
+    EXPECT_GE(binary.comparisons, 20u * 1000);
+    EXPECT_LT(interpolation.comparisons * 2, binary.comparisons);
+}
+TEST(SortedSearcher, ChoosesStrategy) {
+    std::vector<int> uniform = sorted_random(10000, 1000000, 7), skewed, small = {1, 2, 3};
+    for (int i = 0; i != 10000; ++i) skewed.push_back(i * i);
+    SortedSearcher<std::vector<int>::iterator> a(uniform.begin(), uniform.end());
+    SortedSearcher<std::vector<int>::iterator> b(skewed.begin(), skewed.end());
+    SortedSearcher<std::vector<int>::iterator> c(small.begin(), small.end());
+    EXPECT_EQ(SearchStrategy::Interpolation, a.strategy());
+    EXPECT_EQ(SearchStrategy::Binary, b.strategy());
+    EXPECT_EQ(SearchStrategy::Binary, c.strategy());
+
+    for (auto *data : {&uniform, &skewed}) {
+        SortedSearcher<std::vector<int>::iterator> searcher(data->begin(), data->end());
+        for (size_t i = 0; i < data->size(); i += 37) {
+            int key = (*data)[i];
+            auto range = searcher.equal_range(key);
+            auto expected = std::equal_range(data->begin(), data->end(), key);
+            ASSERT_EQ(expected.first, range.first);
+            ASSERT_EQ(expected.second, range.second);
+            ASSERT_EQ(expected.first, searcher.find(key));
+            ASSERT_EQ(expected.second, searcher.upper_bound(key));
+        }
+        EXPECT_EQ(data->end(), searcher.find(-1));
+    }
+
+    // 非默认的比较器只用二分
+    std::vector<int> desc(uniform.rbegin(), uniform.rend());
+    SortedSearcher<std::vector<int>::iterator, std::greater<>> d(desc.begin(), desc.end(),
+                                                                 std::greater<>());
+    EXPECT_EQ(SearchStrategy::Binary, d.strategy());
+    EXPECT_EQ(std::lower_bound(desc.begin(), desc.end(), desc[500], std::greater<>()),
+              d.lower_bound(desc[500]));
+}
 
 }  // namespace alg::test
@@ -1,15 +1,188 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 #include "array.hpp"
+#include "instrument.hpp"
+#include "sort/heap_sort.hpp"
+#include "sort/indirect_sort.hpp"
 #include "sort/insertion_sort.hpp"
 #include "sort/merge_sort.hpp"
 #include "sort/quick_sort.hpp"
+#include "sort/select.hpp"
 #include "sort/selection_sort.hpp"
 #include "sort/shell_sort.hpp"
+#include "sort/sorting_network.hpp"
+#include "sort/tim_sort.hpp"
 #include "test_utility.hpp"
+#include "top_k.hpp"
 
 namespace alg::test {
 
+TEST(TimSort, Random) {
+    std::mt19937 rand(5);
+    for (size_t n : {0, 1, 2, 31, 32, 33, 1000, 100000}) {
+        std::vector<int> v(n);
+        for (int &x : v) x = static_cast<int>(rand() % 1000);
+        std::vector<int> expected = v;
+        std::sort(expected.begin(), expected.end());
+        tim_sort(v.begin(), v.end());
+        EXPECT_EQ(expected, v) << n;
+    }
+}
+TEST(TimSort, Stable) {
+    // 只按 first 比较, second 记录原来的位置
+    std::mt19937 rand(7);
+    std::vector<std::pair<int, int>> v(50000);
+    for (int i = 0; i != 50000; ++i) v[i] = {static_cast<int>(rand() % 100), i};
+    // 插入较长的有序段和逆序段, 让归并进入 galloping 模式
+    std::sort(v.begin() + 1000, v.begin() + 20000);
+    std::sort(v.begin() + 30000, v.begin() + 40000, std::greater<>());
+    std::vector<std::pair<int, int>> expected = v;
+    auto by_key = [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; };
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    tim_sort(v.begin(), v.end(), by_key);
+    EXPECT_EQ(expected, v);
+}
+TEST(TimSort, LinearOnPresortedInput) {
+    std::vector<int> asc(100000), desc(100000);
+    for (int i = 0; i != 100000; ++i) asc[i] = i, desc[i] = -i;
+    OpCounts counts;
+    {
+        CountOps scope(counts);
+        tim_sort(asc.begin(), asc.end(), counting(compare_asc<int>));
+        tim_sort(desc.begin(), desc.end(), counting(compare_asc<int>));
+    }
+    EXPECT_TRUE(std::is_sorted(asc.begin(), asc.end()));
+    EXPECT_TRUE(std::is_sorted(desc.begin(), desc.end()));
+    EXPECT_EQ(2 * (asc.size() - 1), counts.comparisons);
+
+    // 在有序序列末尾追加少量乱序元素, 比较次数仍接近线性
+    std::vector<int> log(100000);
+    for (int i = 0; i != 100000; ++i) log[i] = i;
+    std::shuffle(log.end() - 100, log.end(), std::mt19937(9));
+    std::vector<int> expected = log;
+    std::sort(expected.begin(), expected.end());
+    OpCounts nearly;
+    {
+        CountOps scope(nearly);
+        tim_sort(log.begin(), log.end(), counting(compare_asc<int>));
+    }
+    EXPECT_EQ(expected, log);
+    EXPECT_LT(nearly.comparisons, 2 * log.size());
+}
+TEST(IndirectSort, Argsort) {
+    std::vector<std::string> names{"d", "b", "a", "c", "b"};
+    Vector<size_t> perm = argsort(names.begin(), names.end());
+    EXPECT_EQ(Vector<size_t>({2, 1, 4, 3, 0}), perm);
+    // 原序列不变
+    EXPECT_EQ("d", names[0]);
+
+    apply_permutation(names.begin(), names.end(), perm.begin());
+    EXPECT_EQ(std::vector<std::string>({"a", "b", "b", "c", "d"}), names);
+}
+TEST(IndirectSort, ApplyPermutation) {
+    std::mt19937 rand(13);
+    std::vector<int> perm(1000), values(1000);
+    for (int i = 0; i != 1000; ++i) perm[i] = i, values[i] = i * 10;
+    std::shuffle(perm.begin(), perm.end(), rand);
+    apply_permutation(values.begin(), values.end(), perm.begin());
+    for (int i = 0; i != 1000; ++i) ASSERT_EQ(perm[i] * 10, values[i]);
+}
+TEST(IndirectSort, SortByKey) {
+    struct Record {
+        int id;
+        char payload[200];
+    };
+    std::mt19937 rand(17);
+    std::vector<Record> records(5000);
+    for (int i = 0; i != 5000; ++i) records[i] = {static_cast<int>(rand() % 100), {}};
+    for (int i = 0; i != 5000; ++i) records[i].payload[0] = static_cast<char>(i % 128);
+    std::vector<Record> expected = records;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const Record &lhs, const Record &rhs) { return lhs.id > rhs.id; });
+
+    size_t extracted = 0;
+    sort_by_key(
+        records.begin(), records.end(),
+        [&extracted](const Record &r) {
+            ++extracted;
+            return r.id;
+        },
+        std::greater<int>());
+    EXPECT_EQ(records.size(), extracted);
+    for (size_t i = 0; i != records.size(); ++i) {
+        ASSERT_EQ(expected[i].id, records[i].id);
+        ASSERT_EQ(expected[i].payload[0], records[i].payload[0]);
+    }
+}
+namespace {
+
+constexpr Array<int, 10> sorted_table() {
+    Array<int, 10> table{};
+    int values[] = {42, 7, 19, 3, 88, 7, -5, 61, 0, 23};
+    for (size_t i = 0; i != table.size(); ++i) table[i] = values[i];
+    sort(table);
+    return table;
+}
+
+// 0-1 原理: 排序网络能排好所有 0-1 序列, 就能排好任意序列
+template <size_t N>
+void check_network_01() {
+    for (unsigned bits = 0; bits != (1u << N); ++bits) {
+        Array<int, N> arr{};
+        for (size_t i = 0; i != N; ++i) arr[i] = (bits >> i) & 1;
+        sort(arr);
+        ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end())) << N << " " << bits;
+    }
+}
+template <size_t... Ns>
+void check_networks_01(std::index_sequence<Ns...>) {
+    (check_network_01<Ns + 1>(), ...);
+}
+template <size_t N>
+void check_network_random(std::mt19937 &rand) {
+    for (int round = 0; round != 200; ++round) {
+        Array<int, N> arr;
+        for (int &x : arr) x = static_cast<int>(rand() % 20);
+        std::vector<int> expected(arr.begin(), arr.end());
+        std::sort(expected.begin(), expected.end(), std::greater<int>());
+        sort(arr, compare_desc<int>);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), arr.begin())) << N;
+    }
+}
+template <size_t... Ns>
+void check_networks_random(std::index_sequence<Ns...>) {
+    std::mt19937 rand(19);
+    (check_network_random<Ns + 1>(rand), ...);
+}
+
+}  // namespace
+
+TEST(SortingNetwork, Constexpr) {
+    constexpr Array<int, 10> table = sorted_table();
+    static_assert(table[0] == -5 && table[1] == 0 && table[9] == 88);
+    EXPECT_TRUE(std::is_sorted(table.begin(), table.end()));
+    static_assert(__network_size<4>() == 5 && __network_size<8>() == 19);
+}
+TEST(SortingNetwork, ZeroOnePrinciple) { check_networks_01(std::make_index_sequence<16>()); }
+TEST(SortingNetwork, Random) { check_networks_random(std::make_index_sequence<33>()); }
+TEST(SortingNetwork, NonArithmetic) {
+    Array<std::string, 5> names;
+    const char *values[] = {"pear", "apple", "fig", "kiwi", "banana"};
+    for (size_t i = 0; i != 5; ++i) names[i] = values[i];
+    sort(names);
+    EXPECT_EQ("apple", names[0]);
+    EXPECT_EQ("pear", names[4]);
+    EXPECT_EQ("pear", *names.rbegin());
+
+    Array<int, 40> large;
+    gen_random_seq(large.begin(), large.end());
+    sort(large);
+    EXPECT_TRUE(is_sorted(large.begin(), large.end()));
+}
 TEST(SelectionSort, Asc) {
     Array<int, 9> arr;
     gen_random_seq(arr.begin(), arr.end());
@@ -80,5 +253,128 @@ TEST(QuickSort, Desc) {
     EXPECT_TRUE(is_sorted(arr.begin(), arr.end(), compare_desc<int>))
         << gen_content_str(arr.begin(), arr.end());
 }
+TEST(QuickSort, ManyDuplicates) {
+    std::vector<int> v(10000);
+    for (size_t i = 0; i != v.size(); ++i) v[i] = static_cast<int>(i % 3);
+    quick_sort(v.begin(), v.end());
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    std::vector<int> equal(10000, 1), empty;
+    quick_sort(equal.begin(), equal.end());
+    quick_sort(empty.begin(), empty.end());
+    EXPECT_EQ(std::vector<int>(10000, 1), equal);
+}
+TEST(HeapSort, Asc) {
+    Array<int, 100> arr;
+    gen_random_seq(arr.begin(), arr.end());
+    heap_sort(arr.begin(), arr.end());
+    EXPECT_TRUE(is_sorted(arr.begin(), arr.end()))
+        << gen_content_str(arr.begin(), arr.end());
+}
+TEST(HeapSort, Desc) {
+    Array<int, 100> arr;
+    gen_random_seq(arr.begin(), arr.end());
+    heap_sort(arr.begin(), arr.end(), compare_desc<int>);
+    EXPECT_TRUE(is_sorted(arr.begin(), arr.end(), compare_desc<int>))
+        << gen_content_str(arr.begin(), arr.end());
+}
+TEST(NthElement, Random) {
+    std::mt19937 rand(3);
+    for (size_t n : {1, 2, 15, 16, 17, 100, 1000}) {
+        std::vector<int> v(n);
+        for (int &x : v) x = rand() % 50;
+        std::vector<int> sorted = v;
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t k : {size_t(0), n / 3, n / 2, n - 1}) {
+            std::vector<int> w = v;
+            alg::nth_element(w.begin(), w.begin() + k, w.end());
+            ASSERT_EQ(sorted[k], w[k]);
+            for (size_t i = 0; i != k; ++i) ASSERT_LE(w[i], w[k]);
+            for (size_t i = k; i != n; ++i) ASSERT_GE(w[i], w[k]);
+        }
+    }
+}
+TEST(NthElement, AdversarialInputs) {
+    // 已排序, 逆序和全部相等的输入都不应退化
+    std::vector<int> asc(100000), desc(100000), equal(100000, 7);
+    for (int i = 0; i != 100000; ++i) asc[i] = i, desc[i] = 100000 - i;
+    alg::nth_element(asc.begin(), asc.begin() + 50000, asc.end());
+    alg::nth_element(desc.begin(), desc.begin() + 50000, desc.end());
+    alg::nth_element(equal.begin(), equal.begin() + 50000, equal.end(), compare_desc<int>);
+    EXPECT_EQ(50000, asc[50000]);
+    EXPECT_EQ(50001, desc[50000]);
+    EXPECT_EQ(7, equal[50000]);
+}
+TEST(PartialSort, SmallestK) {
+    Array<int, 100> arr;
+    gen_random_seq(arr.begin(), arr.end());
+    std::vector<int> expected(arr.begin(), arr.end());
+    std::sort(expected.begin(), expected.end());
+    partial_sort(arr.begin(), arr.begin() + 10, arr.end());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.begin() + 10, arr.begin()))
+        << gen_content_str(arr.begin(), arr.end());
+}
+TEST(TopK, Stream) {
+    TopK<int> top(5);
+    EXPECT_EQ(nullptr, top.threshold());
+    std::vector<int> all;
+    std::mt19937 rand(11);
+    for (int batch = 0; batch != 100; ++batch) {
+        std::vector<int> values(1000);
+        for (int &x : values) x = rand() % 1000000;
+        top.push(values.begin(), values.end());
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end(), std::greater<int>());
+    Vector<int> result = top.result();
+    ASSERT_EQ(5u, result.size());
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), all.begin()));
+    ASSERT_NE(nullptr, top.threshold());
+    EXPECT_LE(*top.threshold(), all[4]);
+
+    TopK<std::string, std::greater<std::string>> smallest(2);
+    for (const char *s : {"d", "b", "a", "c"}) smallest.push(s);
+    EXPECT_EQ(Vector<std::string>({"a", "b"}), smallest.result());
+}
+TEST(SortInstrumentation, CountsOperations) {
+    Array<Counted<int>, 64> arr;
+    gen_random_seq(arr.begin(), arr.end());
+    OpCounts counts;
+    {
+        CountOps scope(counts);
+        insertion_sort(arr.begin(), arr.end());
+    }
+    EXPECT_TRUE(is_sorted(arr.begin(), arr.end()));
+    EXPECT_GE(counts.comparisons, arr.size() - 1);
+    EXPECT_GE(counts.swaps, 1u);
+    EXPECT_EQ(0u, counts.copies);
+
+    // 作用域外的操作不计数
+    OpCounts outside = counts;
+    insertion_sort(arr.begin(), arr.end());
+    EXPECT_EQ(outside.comparisons, counts.comparisons);
+}
+TEST(SortInstrumentation, MergeSortDoesNotCopy) {
+    Array<Counted<int>, 64> arr;
+    gen_random_seq(arr.begin(), arr.end());
+    OpCounts counts;
+    {
+        CountOps scope(counts);
+        merge_sort(arr);
+    }
+    EXPECT_TRUE(is_sorted(arr.begin(), arr.end()));
+    EXPECT_EQ(0u, counts.copies);
+    EXPECT_GT(counts.moves, 0u);
+}
+TEST(SortInstrumentation, CountingComparer) {
+    Array<int, 64> arr;
+    gen_random_seq(arr.begin(), arr.end());
+    OpCounts counts;
+    {
+        CountOps scope(counts);
+        shell_sort(arr, counting(compare_desc<int>));
+    }
+    EXPECT_TRUE(is_sorted(arr.begin(), arr.end(), compare_desc<int>));
+    EXPECT_GE(counts.comparisons, arr.size() - 1);
+}
 
 }  // namespace alg::test
@@ -1,6 +1,13 @@
 ﻿#include "string.hpp"
+#include "utf8_decoder.hpp"
+#include "utf8_search.hpp"
+#include "utf8_view.hpp"
 #include <gtest/gtest.h>
 
+#include <iterator>
+#include <string_view>
+#include <vector>
+
 namespace alg::test {
 
 std::string str1 = u8"abcdefghijklmnopqrstuvwxyz";
@@ -9,6 +16,22 @@ std::string str3 = u8"嘿!你好😂";
 TEST(String_Utf8WalkLength, FullyAscii) { ASSERT_EQ(utf8_walk_length(str1), 26); }
 TEST(String_Utf8WalkLength, WithChinese) { ASSERT_EQ(utf8_walk_length(str2), 7); }
 TEST(String_Utf8WalkLength, WithEmoji) { ASSERT_EQ(utf8_walk_length(str3), 5); }
+TEST(String_Utf8WalkLength, View) {
+    std::string_view view(str2);
+    ASSERT_EQ(utf8_walk_length(view.substr(0, 4)), 2);
+    ASSERT_EQ(utf8_walk_length(str3.data(), str3.size()), 5);
+}
+TEST(String_Utf8WalkLength, LargeBuffer) {
+    // 超过 255 个向量块, 且长度不是向量宽度的整数倍
+    std::string str;
+    std::string::size_type expected = 0;
+    while (str.size() < 100000) {
+        str += str1 + str2 + str3;
+        expected += 26 + 7 + 5;
+    }
+    str += u8"嘿";
+    ASSERT_EQ(utf8_walk_length(str), expected + 1);
+}
 
 TEST(String_Utf8CharAt, FullyAscii) { ASSERT_EQ(utf8_char_at(str1, 1), u8"b"); }
 TEST(String_Utf8CharAt, WithChinese) { ASSERT_EQ(utf8_char_at(str2, 3), u8"好"); }
@@ -18,6 +41,160 @@ TEST(String_Utf8CharAt, NonStardard) {
     str[0] = 0xBF;
     ASSERT_THROW(utf8_char_at(str, 0), std::invalid_argument);
 }
+TEST(String_Utf8CharAt, FiveAndSixByteLead) {
+    // 0xF8 和 0xFC 是已废弃的 5 字节和 6 字节序列的首字节
+    ASSERT_THROW(utf8_char_at("a\xF8\x88\x80\x80\x80", 1), std::invalid_argument);
+    ASSERT_THROW(utf8_char_at("a\xFC\x84\x80\x80\x80\x80", 1), std::invalid_argument);
+}
+TEST(String_Utf8CharAt, Truncated) {
+    // 最后一个字符缺少后续字节
+    ASSERT_THROW(utf8_char_at("ab\xE4\xBD", 2), std::invalid_argument);
+    ASSERT_THROW(utf8_char_at("\xF0\x9F\x98", 0), std::invalid_argument);
+}
 TEST(String_Utf8CharAt, OutOfRange) { ASSERT_THROW(utf8_char_at(str3, 5), std::out_of_range); }
 
+TEST(String_Utf8View, CharAt) {
+    std::string str;
+    for (int i = 0; i != 50; ++i) str += str3;
+    Utf8View view(str);
+    ASSERT_EQ(view.size(), 250);
+    for (std::string::size_type i = 0; i != view.size(); ++i) {
+        ASSERT_EQ(view.char_at(i), utf8_char_at(str, i));
+    }
+    ASSERT_EQ(view[249], u8"😂");
+    ASSERT_THROW(view.char_at(250), std::out_of_range);
+}
+TEST(String_Utf8View, Iterate) {
+    Utf8View view(str2);
+    std::string joined;
+    for (std::string_view ch : view) joined += std::string(ch) + "|";
+    ASSERT_EQ(joined, u8"嘿|!|你|好|a|b|c|");
+    ASSERT_EQ(*std::prev(view.end()), "c");
+    ASSERT_EQ(std::distance(view.begin(), view.end()), 7);
+}
+TEST(String_Utf8View, Substr) {
+    Utf8View view(str2);
+    ASSERT_EQ(view.substr(2, 2).bytes(), u8"你好");
+    ASSERT_EQ(view.substr(4).bytes(), "abc");
+    ASSERT_EQ(view.substr(7).size(), 0);
+    ASSERT_EQ(view.byte_offset(7), str2.size());
+    ASSERT_THROW(view.substr(8), std::out_of_range);
+}
+
+TEST(String_Utf8Validate, Valid) {
+    ASSERT_EQ(utf8_validate(str1), std::string::npos);
+    ASSERT_EQ(utf8_validate(str3), std::string::npos);
+    ASSERT_EQ(utf8_validate("\xF4\x8F\xBF\xBF"), std::string::npos);  // U+10FFFF
+}
+TEST(String_Utf8Validate, Invalid) {
+    ASSERT_EQ(utf8_validate("ab\x80"), 2);              // 单独的延续字节
+    ASSERT_EQ(utf8_validate("a\xC0\x80"), 1);           // 超长编码
+    ASSERT_EQ(utf8_validate("\xE0\x9F\xBF"), 0);        // 超长编码
+    ASSERT_EQ(utf8_validate("\xED\xA0\x80"), 0);        // 代理区
+    ASSERT_EQ(utf8_validate("\xF4\x90\x80\x80"), 0);    // 超过 U+10FFFF
+    ASSERT_EQ(utf8_validate("\xF8\x88\x80\x80\x80"), 0);  // 5 字节形式
+    ASSERT_EQ(utf8_validate("abc\xE4\xBD"), 3);         // 截断
+}
+TEST(String_Utf8Validate, LargeBuffer) {
+    std::string str;
+    while (str.size() < 10000) str += str3;
+    ASSERT_EQ(utf8_validate(str), std::string::npos);
+    std::string::size_type pos = str.size() - 100;
+    while ((str[pos] & 0xC0) == 0x80) ++pos;
+    str.insert(pos, "\xE4\xBD");
+    ASSERT_EQ(utf8_validate(str), pos);
+}
+TEST(String_Transcode, RoundTrip) {
+    std::u16string u16;
+    std::u32string u32;
+    std::string back;
+    ASSERT_EQ(utf8_to_utf16(str3, u16), std::string::npos);
+    ASSERT_EQ(u16, u"嘿!你好😂");
+    ASSERT_EQ(utf16_to_utf8(u16, back), std::string::npos);
+    ASSERT_EQ(back, str3);
+    ASSERT_EQ(utf8_to_utf32(str2, u32), std::string::npos);
+    ASSERT_EQ(u32, U"嘿!你好abc");
+    ASSERT_EQ(utf32_to_utf8(u32, back), std::string::npos);
+    ASSERT_EQ(back, str2);
+}
+TEST(String_Transcode, ErrorPosition) {
+    std::u16string u16;
+    std::u32string u32;
+    std::string u8;
+    ASSERT_EQ(utf8_to_utf16("ab\xED\xA0\x80", u16), 2);
+    ASSERT_EQ(u16, u"ab");
+    ASSERT_EQ(utf8_to_utf32("\xC3", u32), 0);
+    ASSERT_TRUE(u32.empty());
+    std::u16string lone = u"a";
+    lone += static_cast<char16_t>(0xDC00);
+    ASSERT_EQ(utf16_to_utf8(lone, u8), 1);
+    ASSERT_EQ(u8, "a");
+    ASSERT_EQ(utf32_to_utf8(std::u32string(1, static_cast<char32_t>(0x110000)), u8), 0);
+}
+
+TEST(String_Utf8Decoder, SplitChunks) {
+    // 在每个字节位置切成两块
+    for (std::string::size_type cut = 0; cut <= str3.size(); ++cut) {
+        Utf8Decoder decoder;
+        std::u32string result;
+        auto append = [&result](char32_t cp) { result += cp; };
+        std::string_view first(str3.data(), cut), second(str3.data() + cut, str3.size() - cut);
+        decoder.decode(first, append);
+        std::string::size_type boundary = first.size() - decoder.pending_bytes();
+        ASSERT_EQ(utf8_walk_length(first.substr(0, boundary)), decoder.code_points());
+        decoder.decode(second, append);
+        decoder.finish();
+        ASSERT_EQ(result, U"嘿!你好😂");
+    }
+}
+TEST(String_Utf8Decoder, ByteByByte) {
+    std::string str;
+    for (int i = 0; i != 10; ++i) str += str1 + str2 + str3;
+    Utf8Decoder decoder;
+    for (char b : str) decoder.feed(std::string_view(&b, 1));
+    decoder.finish();
+    ASSERT_EQ(decoder.code_points(), utf8_walk_length(str));
+    ASSERT_EQ(decoder.bytes(), str.size());
+}
+TEST(String_Utf8Decoder, Invalid) {
+    Utf8Decoder truncated;
+    truncated.feed("ab\xF0\x9F");
+    ASSERT_EQ(truncated.pending_bytes(), 2);
+    ASSERT_THROW(truncated.finish(), std::invalid_argument);
+    Utf8Decoder surrogate;
+    surrogate.feed("\xED");
+    ASSERT_THROW(surrogate.feed("\xA0\x80"), std::invalid_argument);
+}
+
+TEST(String_Utf8Searcher, Find) {
+    Utf8Searcher searcher(u8"你好");
+    Utf8Match m = searcher.find(str2);
+    ASSERT_TRUE(m);
+    ASSERT_EQ(m.byte_offset, 4);
+    ASSERT_EQ(m.char_offset, 2);
+    ASSERT_FALSE(searcher.find(str1));
+    ASSERT_EQ(Utf8Searcher("c").find(str2).char_offset, 6);
+}
+TEST(String_Utf8Searcher, FindAll) {
+    std::string str;
+    for (int i = 0; i != 100; ++i) str += str3 + str1;
+    Utf8Searcher searcher(u8"😂abc");
+    std::vector<Utf8Match> matches;
+    searcher.find_all(str, [&matches](const Utf8Match &m) { matches.push_back(m); });
+    ASSERT_EQ(matches.size(), 100);
+    for (std::string::size_type i = 0; i != matches.size(); ++i) {
+        ASSERT_EQ(matches[i].byte_offset, str.find(u8"😂abc", i == 0 ? 0 : matches[i - 1].byte_offset + 1));
+        ASSERT_EQ(matches[i].char_offset, i * (5 + 26) + 4);
+    }
+}
+TEST(String_Utf8MultiSearcher, Leftmost) {
+    Utf8MultiSearcher searcher({"xyz", u8"好", "!"});
+    Utf8Match m = searcher.find(str2);
+    ASSERT_EQ(m.needle, 2);
+    ASSERT_EQ(m.char_offset, 1);
+    std::vector<std::string::size_type> needles;
+    searcher.find_all(str1 + str2, [&needles](const Utf8Match &m) { needles.push_back(m.needle); });
+    ASSERT_EQ(needles, std::vector<std::string::size_type>({0, 2, 1}));
+}
+
 }  // namespace alg::test
\ No newline at end of file
@@ -1,6 +1,17 @@
 #include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "huge_page_allocator.hpp"
 #include "union_find/quick_find.hpp"
+#include "union_find/persistent_union_find.hpp"
 #include "union_find/quick_union.hpp"
+#include "union_find/rollback_union_find.hpp"
 
 namespace alg::test {
 
@@ -9,7 +20,8 @@ struct UnionFindTest : public ::testing::Test {
     using UFImpl = UF;
 };
 
-using UFImpls = ::testing::Types<alg::QuickFind, alg::QuickUnion>;
+using UFImpls =
+    ::testing::Types<QuickFind, QuickFind64, QuickUnion, QuickUnion64, RollbackUnionFind>;
 TYPED_TEST_CASE(UnionFindTest, UFImpls);
 
 TYPED_TEST(UnionFindTest, Normal) {
@@ -21,4 +33,157 @@ TYPED_TEST(UnionFindTest, Normal) {
     EXPECT_FALSE(uf.is_connected(9, 4));
 }
 
+TEST(QuickUnion, MatchesReference) {
+    std::mt19937 rand(31);
+    const size_t n = 5000;
+    QuickUnion uf(n);
+    RollbackUnionFind reference(n);
+    for (int i = 0; i != 4000; ++i) {
+        size_t a = rand() % n, b = rand() % n;
+        uf.connect(a, b);
+        reference.connect(a, b);
+    }
+    for (int i = 0; i != 10000; ++i) {
+        size_t a = rand() % n, b = rand() % n;
+        ASSERT_EQ(reference.is_connected(a, b), uf.is_connected(a, b));
+    }
+}
+TEST(QuickUnion, IndexWidth) {
+    // 最高位用来标记根, uint8_t 最多 128 个节点
+    EXPECT_NO_THROW(BasicQuickUnion<uint8_t>(128));
+    EXPECT_THROW(BasicQuickUnion<uint8_t>(129), std::invalid_argument);
+    // QuickFind 只存下标 [0, n), uint8_t 最多 256 个节点
+    EXPECT_NO_THROW(BasicQuickFind<uint8_t>(256));
+    EXPECT_THROW(BasicQuickFind<uint8_t>(257), std::invalid_argument);
+    EXPECT_NO_THROW(BasicQuickFind<uint16_t>(65536));
+#if SIZE_MAX > UINT32_MAX
+    // 在分配之前检查, 否则会先因为分配几 TB 失败
+    EXPECT_THROW(QuickFind(size_t(1) << 40), std::invalid_argument);
+    EXPECT_THROW(QuickUnion(size_t(1) << 40), std::invalid_argument);
+    EXPECT_THROW(PersistentUnionFind(size_t(1) << 40), std::invalid_argument);
+#endif
+    EXPECT_EQ(sizeof(uint32_t), sizeof(QuickUnion::index_type));
+}
+TEST(HugePageAllocator, LargeAndSmall) {
+    std::vector<uint64_t, HugePageAllocator<uint64_t>> big(3 << 20, 7), small(10, 1);
+#if !defined(_WIN32)
+    // Windows 没有大页权限时退回普通页, 只按 64KB 对齐
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(big.data()) % huge_pages::HUGE_PAGE_SIZE);
+#endif
+    big.back() = 9;
+    EXPECT_EQ(7u, big[12345]);
+    EXPECT_EQ(9u, big.back());
+    EXPECT_EQ(1u, small[9]);
+}
+TEST(RollbackUnionFind, Rollback) {
+    RollbackUnionFind uf(6);
+    EXPECT_TRUE(uf.connect(0, 1));
+    size_t saved = uf.snapshot();
+    EXPECT_TRUE(uf.connect(1, 2));
+    EXPECT_TRUE(uf.connect(3, 4));
+    EXPECT_FALSE(uf.connect(0, 2));
+    EXPECT_EQ(3u, uf.count());
+    EXPECT_TRUE(uf.is_connected(0, 2));
+
+    uf.rollback(saved);
+    EXPECT_EQ(5u, uf.count());
+    EXPECT_TRUE(uf.is_connected(0, 1));
+    EXPECT_FALSE(uf.is_connected(0, 2));
+    EXPECT_FALSE(uf.is_connected(3, 4));
+    EXPECT_THROW(uf.rollback(saved + 1), std::invalid_argument);
+}
+TEST(RollbackUnionFind, DynamicConnectivity) {
+    // 与每个时刻从头建并查集的结果对比
+    std::mt19937 rand(29);
+    const size_t n = 30, times = 60;
+    std::vector<TimedEdge> edges;
+    for (int i = 0; i != 80; ++i) {
+        size_t added = rand() % times, removed = added + rand() % 20;
+        edges.push_back({rand() % n, rand() % n, added, removed});
+    }
+    std::vector<ConnectivityQuery> queries;
+    for (int i = 0; i != 500; ++i) queries.push_back({rand() % n, rand() % n, rand() % times});
+
+    std::vector<bool> answers = dynamic_connectivity(n, edges, queries);
+    ASSERT_EQ(queries.size(), answers.size());
+    for (size_t i = 0; i != queries.size(); ++i) {
+        RollbackUnionFind uf(n);
+        for (const auto &e : edges) {
+            if (e.added <= queries[i].time && queries[i].time < e.removed) uf.connect(e.n1, e.n2);
+        }
+        EXPECT_EQ(uf.is_connected(queries[i].n1, queries[i].n2), answers[i]) << i;
+    }
+}
+TEST(RollbackUnionFind, SparseTimestamps) {
+    // 时刻是 Unix 时间戳, 线段树的大小只与询问的个数有关
+    const size_t base = 1700000000;
+    std::vector<TimedEdge> edges = {{0, 1, base, base + 100}, {1, 2, base + 50, base + 51}};
+    std::vector<ConnectivityQuery> queries = {{0, 1, base - 1},  {0, 1, base + 50}, {0, 2, base + 50},
+                                              {0, 2, base + 51}, {0, 1, base + 100}};
+    EXPECT_EQ(std::vector<bool>({false, true, true, false, false}),
+              dynamic_connectivity(3, edges, queries));
+}
+TEST(PersistentUnionFind, SaveAndOpen) {
+    // 文件名加上随机后缀, 同时运行的多个测试进程不会互相覆盖
+    auto dir = std::filesystem::temp_directory_path();
+    std::string suffix = std::to_string(std::random_device()());
+    std::string path = (dir / ("alg_union_find_test_" + suffix + ".bin")).string();
+    std::string updated = (dir / ("alg_union_find_test_updated_" + suffix + ".bin")).string();
+    {
+        PersistentUnionFind uf(1000);
+        for (size_t i = 0; i + 2 < 1000; i += 2) uf.connect(i, i + 2);
+        uf.connect(1, 3);
+        uf.save(path);
+    }
+    {
+        PersistentUnionFind uf = PersistentUnionFind::open(path);
+        EXPECT_TRUE(uf.is_mapped());
+        EXPECT_EQ(1000u, uf.size());
+        EXPECT_EQ(1000u - 499 - 1, uf.count());
+        EXPECT_TRUE(uf.is_connected(0, 998));
+        EXPECT_TRUE(uf.is_connected(1, 3));
+        EXPECT_FALSE(uf.is_connected(0, 1));
+
+        // 写时复制: 修改只在本对象中可见, 文件不变
+        EXPECT_TRUE(uf.connect(0, 1));
+        EXPECT_TRUE(uf.is_connected(998, 3));
+        EXPECT_FALSE(PersistentUnionFind::open(path).is_connected(0, 1));
+
+        // Windows 上不能替换仍被映射的文件, 因此另存一份
+        uf.save(updated);
+    }
+    EXPECT_TRUE(PersistentUnionFind::open(updated).is_connected(0, 1));
+    // 布局一致但连通分量数大于节点数
+    {
+        std::fstream file(updated, std::ios::in | std::ios::out | std::ios::binary);
+        uint64_t count = 1001;
+        file.seekp(32);
+        file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    }
+    EXPECT_THROW(PersistentUnionFind::open(updated), std::runtime_error);
+    std::filesystem::remove(updated);
+
+    // 父节点数组损坏: 越界的父节点, 以及 1 和 3 互为父节点的环
+    auto write_parent = [&](size_t node, uint32_t parent) {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(64 + node * sizeof(parent));
+        file.write(reinterpret_cast<const char *>(&parent), sizeof(parent));
+    };
+    write_parent(10, 5000);
+    EXPECT_THROW(PersistentUnionFind::open(path).find_root(10), std::runtime_error);
+    write_parent(1, 3);
+    write_parent(3, 1);
+    EXPECT_THROW(PersistentUnionFind::open(path).is_connected(1, 0), std::runtime_error);
+
+    // 损坏的文件头
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(8);
+        file.put(99);
+    }
+    EXPECT_THROW(PersistentUnionFind::open(path), std::runtime_error);
+    std::filesystem::remove(path);
+    EXPECT_THROW(PersistentUnionFind::open(path), std::runtime_error);
+}
+
 }  // namespace alg::test
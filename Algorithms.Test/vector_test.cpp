@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <list>
+#include <sstream>
 
 namespace alg::test {
 
@@ -28,4 +29,53 @@ TEST(Vector, Erase) {
     Vector<std::string> expected({"B", "F"});
     EXPECT_EQ(expected, v);
 }
+TEST(Vector, InsertInputIterator) {
+    Vector<int> v = {1, 5};
+    std::istringstream in("2 3 4");
+    auto iter = v.insert(v.begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    EXPECT_EQ(v.begin() + 1, iter);
+    EXPECT_EQ(Vector<int>({1, 2, 3, 4, 5}), v);
+}
+TEST(Vector, EraseIf) {
+    Vector<std::string> v({"A", "B", "C", "B", "D", "B"});
+    EXPECT_EQ(3u, v.remove("B"));
+    EXPECT_EQ(Vector<std::string>({"A", "C", "D"}), v);
+    EXPECT_EQ(0u, v.remove("B"));
+
+    Vector<int> nums;
+    for (int i = 0; i != 1000; ++i) nums.push_back(i);
+    EXPECT_EQ(500u, nums.erase_if([](int x) { return x % 2 == 1; }));
+    ASSERT_EQ(500u, nums.size());
+    for (int i = 0; i != 500; ++i) EXPECT_EQ(i * 2, nums[i]);
+}
+TEST(Vector, AppendRange) {
+    Vector<std::string> v({"A"});
+    std::list<std::string> l = {"B", "C"};
+    v.append_range(l);
+    v.append_range(std::initializer_list<std::string>{"D"});
+    EXPECT_EQ(Vector<std::string>({"A", "B", "C", "D"}), v);
+
+    Vector<int> nums;
+    std::istringstream in("1 2 3");
+    struct {
+        std::istringstream &in;
+        std::istream_iterator<int> begin() const { return std::istream_iterator<int>(in); }
+        std::istream_iterator<int> end() const { return std::istream_iterator<int>(); }
+    } range{in};
+    nums.append_range(range);
+    EXPECT_EQ(Vector<int>({1, 2, 3}), nums);
+}
+TEST(Vector, InsertAt) {
+    Vector<std::string> v({"A", "C", "E"});
+    size_t positions[] = {0, 1, 2, 3, 3};
+    std::string vals[] = {"0", "B", "D", "F", "G"};
+    v.insert_at(std::begin(positions), std::end(positions), std::begin(vals));
+    EXPECT_EQ(Vector<std::string>({"0", "A", "B", "C", "D", "E", "F", "G"}), v);
+
+    size_t bad[] = {2, 1};
+    EXPECT_THROW(v.insert_at(std::begin(bad), std::end(bad), std::begin(vals)),
+                 std::invalid_argument);
+    size_t out[] = {100};
+    EXPECT_THROW(v.insert_at(std::begin(out), std::end(out), std::begin(vals)), std::out_of_range);
+}
 }  // namespace alg::test
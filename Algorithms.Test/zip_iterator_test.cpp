@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+
+#include "instrument.hpp"
+#include "sort/heap_sort.hpp"
+#include "sort/insertion_sort.hpp"
+#include "sort/merge_sort.hpp"
+#include "sort/quick_sort.hpp"
+#include "sort/tim_sort.hpp"
+#include "vector.hpp"
+#include "zip_iterator.hpp"
+
+namespace alg::test {
+
+namespace {
+
+// 三列: 键, 原始位置, 由键和位置生成的字符串
+struct Columns {
+    Vector<int> keys;
+    Vector<size_t> index;
+    Vector<std::string> names;
+
+    explicit Columns(size_t n, int range) {
+        std::mt19937 rand(static_cast<unsigned>(n));
+        for (size_t i = 0; i != n; ++i) {
+            int key = static_cast<int>(rand() % range);
+            keys.push_back(key);
+            index.push_back(i);
+            names.push_back(std::to_string(key) + "#" + std::to_string(i));
+        }
+    }
+    auto begin() { return make_zip_iterator(keys.begin(), index.begin(), names.begin()); }
+    auto end() { return make_zip_iterator(keys.end(), index.end(), names.end()); }
+
+    // 各列仍然对齐, 并且按键有序; stable 时相同的键保持原来的顺序
+    void check(bool stable) const {
+        for (size_t i = 0; i != keys.size(); ++i) {
+            ASSERT_EQ(std::to_string(keys[i]) + "#" + std::to_string(index[i]), names[i]);
+            if (i == 0) continue;
+            ASSERT_LE(keys[i - 1], keys[i]);
+            if (stable && keys[i - 1] == keys[i]) {
+                ASSERT_LT(index[i - 1], index[i]);
+            }
+        }
+    }
+};
+
+}  // namespace
+
+TEST(ZipIterator, ReferenceSemantics) {
+    Vector<int> a{1, 2};
+    Vector<std::string> b{"x", "y"};
+    auto it = make_zip_iterator(a.begin(), b.begin());
+    EXPECT_EQ(2, (it + 2) - it);
+
+    // 赋值和交换都作用于各列的元素
+    swap(*it, *(it + 1));
+    EXPECT_EQ(Vector<int>({2, 1}), a);
+    EXPECT_EQ(Vector<std::string>({"y", "x"}), b);
+
+    std::tuple<int, std::string> value = *it;
+    it[1] = value;
+    EXPECT_EQ(Vector<int>({2, 2}), a);
+    EXPECT_EQ("y", b[1]);
+    *it = std::make_tuple(5, std::string("z"));
+    EXPECT_EQ(5, a[0]);
+    EXPECT_EQ("z", b[0]);
+    EXPECT_FALSE(by_column<0>()(it[1], value));
+}
+TEST(ZipIterator, QuickSort) {
+    Columns cols(5000, 100);
+    quick_sort(cols.begin(), cols.end(), by_column<0>());
+    cols.check(false);
+}
+TEST(ZipIterator, MergeSort) {
+    Columns cols(5000, 100);
+    merge_sort(cols.begin(), cols.end(), by_column<0>());
+    cols.check(true);
+}
+TEST(ZipIterator, InsertionSort) {
+    Columns cols(300, 20);
+    insertion_sort(cols.begin(), cols.end(), by_column<0>());
+    // 先把最小元素交换到最前面作为哨兵, 因此不稳定
+    cols.check(false);
+}
+TEST(ZipIterator, OtherSorts) {
+    Columns tim(5000, 100), heap(5000, 100);
+    tim_sort(tim.begin(), tim.end(), by_column<0>());
+    heap_sort(heap.begin(), heap.end(), by_column<0>());
+    tim.check(true);
+    heap.check(false);
+}
+TEST(ZipIterator, DescendingByOtherColumn) {
+    Columns cols(1000, 10);
+    quick_sort(cols.begin(), cols.end(), by_column<1>(std::greater<size_t>()));
+    for (size_t i = 0; i != 1000; ++i) EXPECT_EQ(999 - i, cols.index[i]);
+}
+TEST(ZipIterator, SortsMoveInsteadOfCopy) {
+    auto sort_counting_copies = [](auto sort) {
+        std::mt19937 rand(17);
+        Vector<int> keys;
+        Vector<Counted<std::string>> payload;
+        for (int i = 0; i != 500; ++i) {
+            int key = static_cast<int>(rand() % 50);
+            keys.push_back(key);
+            payload.push_back(std::to_string(key));
+        }
+        OpCounts counts;
+        {
+            CountOps scope(counts);
+            sort(make_zip_iterator(keys.begin(), payload.begin()),
+                 make_zip_iterator(keys.end(), payload.end()));
+        }
+        for (size_t i = 0; i != keys.size(); ++i) {
+            EXPECT_EQ(std::to_string(keys[i]), payload[i].value());
+        }
+        EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+        return counts.copies;
+    };
+    auto by_key = by_column<0>();
+    EXPECT_EQ(0u, sort_counting_copies([&](auto f, auto l) { insertion_sort(f, l, by_key); }));
+    EXPECT_EQ(0u, sort_counting_copies([&](auto f, auto l) { merge_sort(f, l, by_key); }));
+    EXPECT_EQ(0u, sort_counting_copies([&](auto f, auto l) { tim_sort(f, l, by_key); }));
+    EXPECT_EQ(0u, sort_counting_copies([&](auto f, auto l) { heap_sort(f, l, by_key); }));
+    EXPECT_EQ(0u, sort_counting_copies([&](auto f, auto l) { quick_sort(f, l, by_key); }));
+}
+TEST(ZipIterator, MoveOnlyColumn) {
+    Vector<int> keys{3, 1, 2, 1};
+    Vector<std::unique_ptr<int>> values;
+    for (int key : keys) values.push_back(std::make_unique<int>(key * 10));
+    auto first = make_zip_iterator(keys.begin(), values.begin());
+    auto last = make_zip_iterator(keys.end(), values.end());
+    tim_sort(first, last, by_column<0>());
+    insertion_sort(first, last, by_column<0>(std::greater<>()));
+    merge_sort(first, last, by_column<0>());
+    EXPECT_EQ(Vector<int>({1, 1, 2, 3}), keys);
+    for (size_t i = 0; i != keys.size(); ++i) EXPECT_EQ(keys[i] * 10, *values[i]);
+
+    // iter_move 取出的元素被移走, 原位置留下被移动后的值
+    std::tuple<int, std::unique_ptr<int>> row = iter_move(first + 3);
+    EXPECT_EQ(30, *std::get<1>(row));
+    EXPECT_EQ(nullptr, values[3]);
+    *first = std::move(row);
+    EXPECT_EQ(30, *values[0]);
+}
+
+}  // namespace alg::test